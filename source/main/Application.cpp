@@ -84,6 +84,8 @@ CVar* app_rendersys_override;
 CVar* app_extra_mod_path;
 CVar* app_force_cache_purge;
 CVar* app_force_cache_update;
+CVar* app_export_cache_json;
+CVar* app_cache_content_hash;
 CVar* app_disable_online_api;
 CVar* app_config_long_names;
 
@@ -229,6 +231,11 @@ CVar* gfx_flexbody_cache;
 CVar* gfx_reduce_shadows;
 CVar* gfx_enable_rtshaders;
 CVar* gfx_classic_shaders;
+CVar* gfx_flexbody_culling;
+CVar* gfx_flexbody_lod_range;
+CVar* gfx_flexbody_lod_interval;
+CVar* gfx_flexbody_rigid_range;
+CVar* gfx_flares_max_lights;
 
 // Instance management
 void SetSimTerrain     (TerrainManager* obj)          { g_sim_terrain = obj;}
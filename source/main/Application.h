@@ -250,6 +250,8 @@ extern CVar* app_rendersys_override;
 extern CVar* app_extra_mod_path;
 extern CVar* app_force_cache_purge;
 extern CVar* app_force_cache_update;
+extern CVar* app_export_cache_json;
+extern CVar* app_cache_content_hash;
 extern CVar* app_disable_online_api;
 extern CVar* app_config_long_names;
 
@@ -394,6 +396,11 @@ extern CVar* gfx_flexbody_cache;
 extern CVar* gfx_reduce_shadows;
 extern CVar* gfx_enable_rtshaders;
 extern CVar* gfx_classic_shaders;
+extern CVar* gfx_flexbody_culling;
+extern CVar* gfx_flexbody_lod_range;
+extern CVar* gfx_flexbody_lod_interval;
+extern CVar* gfx_flexbody_rigid_range;
+extern CVar* gfx_flares_max_lights;
 
 // ------------------------------------------------------------------------------------------------
 // Global objects
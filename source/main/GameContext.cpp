@@ -36,15 +36,19 @@
 #include "InputEngine.h"
 #include "OverlayWrapper.h"
 #include "Replay.h"
+#include "RigDef_File.h"
 #include "ScrewProp.h"
 #include "ScriptEngine.h"
 #include "SkyManager.h"
 #include "SkyXManager.h"
 #include "SoundScriptManager.h"
 #include "TerrainManager.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 #include "VehicleAI.h"
 
+#include <set>
+
 using namespace RoR;
 
 // --------------------------------
@@ -254,6 +258,176 @@ Actor* GameContext::SpawnActor(ActorSpawnRequest& rq)
     return fresh_actor;
 }
 
+void GameContext::SpawnActorAsync(ActorSpawnRequest& rq)
+{
+    if (rq.asr_cache_entry != nullptr)
+    {
+        rq.asr_filename = rq.asr_cache_entry->fname;
+    }
+
+    PendingSpawn spawn;
+    spawn.request = rq;
+    spawn.load = std::make_shared<ActorDefLoad>();
+    spawn.load->filename = rq.asr_filename;
+    spawn.load->predefined_on_terrain = (rq.asr_origin == ActorSpawnRequest::Origin::TERRN_DEF);
+    spawn.load_started = m_actor_manager.BeginFetchActorDef(*spawn.load);
+    if (spawn.load_started)
+    {
+        if (!m_spawn_loader)
+        {
+            m_spawn_loader = std::unique_ptr<ThreadPool>(new ThreadPool(1));
+        }
+        std::shared_ptr<ActorDefLoad> load = spawn.load;
+        spawn.task = m_spawn_loader->RunTask([load]() { ActorManager::LoadActorDef(*load); });
+    }
+    else
+    {
+        spawn.load->finished = true;
+    }
+    m_pending_spawns.push_back(spawn);
+}
+
+void GameContext::UpdatePendingSpawns()
+{
+    // Spawn in order of requests, just like when processed synchronously
+    while (!m_pending_spawns.empty() && m_pending_spawns.front().load->finished)
+    {
+        if (!m_pending_spawns.front().load_finished)
+        {
+            PendingSpawn& front = m_pending_spawns.front();
+            front.load_finished = true;
+            std::shared_ptr<RigDef::File> def = front.load->def;
+            if (front.load_started)
+            {
+                def = m_actor_manager.FinishFetchActorDef(*front.load);
+                if (def != nullptr)
+                {
+                    this->PrepareActorResources(front, *def); // Freshly loaded => meshes/textures likely not in memory yet
+                }
+            }
+            if (def == nullptr)
+            {
+                m_pending_spawns.pop_front();
+                continue; // Error already reported
+            }
+        }
+
+        // Wait until meshes and textures are read from disk and decoded
+        Ogre::ResourceBackgroundQueue& rbq = Ogre::ResourceBackgroundQueue::getSingleton();
+        std::vector<Ogre::BackgroundProcessTicket>& tickets = m_pending_spawns.front().prepare_tickets;
+        while (!tickets.empty() && rbq.isProcessComplete(tickets.back()))
+        {
+            tickets.pop_back();
+        }
+        if (!tickets.empty())
+        {
+            break;
+        }
+
+        PendingSpawn spawn = m_pending_spawns.front();
+        m_pending_spawns.pop_front();
+
+#ifdef USE_SOCKETW
+        if (spawn.request.asr_origin == ActorSpawnRequest::Origin::NETWORK)
+        {
+            RoRnet::UserInfo info;
+            if (!App::GetNetwork()->GetUserInfo(spawn.request.net_source_id, info))
+            {
+                continue; // The user left while we were loading
+            }
+            if (m_actor_manager.TakeUnregisteredStream(spawn.request.net_source_id, spawn.request.net_stream_id))
+            {
+                continue; // The stream was unregistered while we were loading
+            }
+        }
+#endif //SOCKETW
+
+        this->SpawnActor(spawn.request); // Finds the definition in cache
+    }
+}
+
+void GameContext::PrepareActorResources(PendingSpawn& spawn, RigDef::File& def)
+{
+    // Only reads files and decodes images on Ogre's work queue; `SpawnActor()` then creates
+    // the scene objects on main thread (the SceneManager isn't thread safe) from prepared data.
+    const std::string& rg = spawn.load->resource_groupname;
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    std::set<std::pair<std::string, std::string>> resources; // {type, name} - unique
+    auto add_resource = [&](const char* type, std::string const& name)
+    {
+        if (!name.empty() && name != "-" && rgm.resourceExists(rg, name))
+        {
+            resources.insert(std::make_pair(std::string(type), name));
+        }
+    };
+
+    std::vector<std::shared_ptr<RigDef::File::Module>> modules;
+    modules.push_back(def.root_module);
+    for (auto& entry : def.user_modules)
+    {
+        modules.push_back(entry.second);
+    }
+    for (auto& module : modules)
+    {
+        for (auto& prop : module->props)
+        {
+            add_resource("Mesh", prop.mesh_name);
+        }
+        for (auto& flexbody : module->flexbodies)
+        {
+            add_resource("Mesh", flexbody->mesh_name);
+        }
+        for (auto& wheel : module->mesh_wheels)
+        {
+            add_resource("Mesh", wheel.mesh_name);
+        }
+        for (auto& wheel : module->flex_body_wheels)
+        {
+            add_resource("Mesh", wheel.rim_mesh_name);
+            add_resource("Mesh", wheel.tyre_mesh_name);
+        }
+        for (auto& mat : module->managed_materials)
+        {
+            add_resource("Texture", mat.diffuse_map);
+            add_resource("Texture", mat.damaged_diffuse_map);
+            add_resource("Texture", mat.specular_map);
+        }
+    }
+
+    Ogre::ResourceBackgroundQueue& rbq = Ogre::ResourceBackgroundQueue::getSingleton();
+    for (auto& res : resources)
+    {
+        Ogre::ResourceManager* mgr = Ogre::ResourceGroupManager::getSingleton()._getResourceManager(res.first);
+        Ogre::ResourcePtr existing = mgr->getResourceByName(res.second, rg);
+        if (!existing.isNull() && existing->getLoadingState() != Ogre::Resource::LOADSTATE_UNLOADED)
+        {
+            continue; // Already prepared or loaded, i.e. by another actor
+        }
+        spawn.prepare_tickets.push_back(rbq.prepare(res.first, res.second, rg));
+    }
+}
+
+void GameContext::DiscardPendingSpawns()
+{
+    // Queued loads return right away; a running one must finish before its resource group may be unloaded.
+    for (PendingSpawn& spawn : m_pending_spawns)
+    {
+        spawn.load->cancelled = true;
+        for (Ogre::BackgroundProcessTicket ticket : spawn.prepare_tickets)
+        {
+            Ogre::ResourceBackgroundQueue::getSingleton().abortRequest(ticket);
+        }
+    }
+    for (PendingSpawn& spawn : m_pending_spawns)
+    {
+        if (spawn.task)
+        {
+            spawn.task->join();
+        }
+    }
+    m_pending_spawns.clear();
+}
+
 void GameContext::ModifyActor(ActorModifyRequest& rq)
 {
     if (rq.amr_type == ActorModifyRequest::Type::SOFT_RESET)
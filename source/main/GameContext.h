@@ -33,10 +33,15 @@
 #include "SceneMouse.h"
 #include "SimData.h"
 
+#include <OgreResourceBackgroundQueue.h>
+
+#include <deque>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace RoR {
 
@@ -85,6 +90,9 @@ public:
     // Actors
 
     Actor*              SpawnActor(ActorSpawnRequest& rq);
+    void                SpawnActorAsync(ActorSpawnRequest& rq); //!< Loads the definition on a worker thread, see `UpdatePendingSpawns()`
+    void                UpdatePendingSpawns();  //!< Spawns actors whose definitions finished loading, in order of requests; call with physics halted.
+    void                DiscardPendingSpawns(); //!< Cancels loads and waits for running ones; call before unloading resources.
     void                ModifyActor(ActorModifyRequest& rq);
     void                DeleteActor(Actor* actor);
     void                UpdateActors();
@@ -150,6 +158,19 @@ private:
     Ogre::String        m_last_section_config;
     ActorSpawnRequest   m_current_selection;                //!< Context of the loader UI
 
+    struct PendingSpawn
+    {
+        ActorSpawnRequest             request;
+        std::shared_ptr<ActorDefLoad> load;
+        std::shared_ptr<Task>         task;                 //!< Set if the load runs on `m_spawn_loader`
+        bool                          load_started = false; //!< False if the definition was already loaded or failed to load
+        bool                          load_finished = false;//!< True once `FinishFetchActorDef()` ran on main thread
+        std::vector<Ogre::BackgroundProcessTicket> prepare_tickets; //!< Meshes/textures being read and decoded by Ogre's work queue
+    };
+    void                PrepareActorResources(PendingSpawn& spawn, RigDef::File& def);
+    std::deque<PendingSpawn> m_pending_spawns;              //!< Actor definitions being loaded on worker threads
+    std::unique_ptr<ThreadPool> m_spawn_loader;             //!< Dedicated worker, so that long parsing never delays physics tasks on the shared pool
+
     // Characters (simplified physics and netcode)
     CharacterFactory    m_character_factory;
 
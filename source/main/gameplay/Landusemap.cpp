@@ -25,38 +25,56 @@
 #include "ErrorUtils.h"
 #include "Language.h"
 #include "TerrainManager.h"
+#include "PlatformUtils.h"
 #include "PropertyMaps.h"
 #include "PagedGeometry.h"
 
 #include <OgreConfigFile.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 using namespace Ogre;
 using namespace RoR;
 
-Landusemap::Landusemap(String configFilename) :
-    data(0)
+// Landuse cache file, see `Collisions::setupLandUse()`
+static const char*    LANDUSE_CACHE_SIGNATURE = "RoR Landuse";
+static const size_t   LANDUSE_CACHE_SIGNATURE_LENGTH = 16;
+static const uint32_t LANDUSE_CACHE_FORMAT_VERSION = 1;
+static const size_t   LANDUSE_TILES_ALIGNMENT = 64; //!< Tile data starts at a cache line boundary
+
+struct LandusemapCacheHeader
+{
+    char     signature[LANDUSE_CACHE_SIGNATURE_LENGTH];
+    uint32_t file_format_version;
+    uint32_t num_ground_models;
+    int32_t  size_x;
+    int32_t  size_z;
+    uint64_t source_size; //!< Fingerprint of the terrain ZIP/file
+    int64_t  source_time; //!< Fingerprint of the terrain ZIP/file
+    uint32_t texture_filename_length;
+    uint32_t tiles_offset; //!< From start of file, aligned to `LANDUSE_TILES_ALIGNMENT`
+};
+
+Landusemap::Landusemap(String configFilename, std::string const& cache_filename, uint64_t source_size, int64_t source_time) :
+    m_tiles(nullptr)
+    , m_cache_filename(cache_filename)
+    , m_cache_source_size(source_size)
+    , m_cache_source_time(source_time)
+    , m_num_tiles_x(0)
+    , m_num_tiles_z(0)
+    , m_size_x(0)
+    , m_size_z(0)
     , default_ground_model(nullptr)
     , mapsize(App::GetSimTerrain()->getMaxTerrainSize())
 {
+    m_ground_models.push_back(nullptr);
     loadConfig(configFilename);
 }
 
 Landusemap::~Landusemap()
 {
-    if (data != nullptr)
-        delete[] data;
-}
-
-ground_model_t* Landusemap::getGroundModelAt(int x, int z)
-{
-    if (!data)
-        return nullptr;
-
-    // we return the default ground model if we are not anymore in this map
-    if (x < 0 || x >= mapsize.x || z < 0 || z >= mapsize.z)
-        return default_ground_model;
-
-    return data[x + z * (int)mapsize.x];
 }
 
 int Landusemap::loadConfig(const Ogre::String& filename)
@@ -126,6 +144,18 @@ int Landusemap::loadConfig(const Ogre::String& filename)
             }
         }
     }
+
+    m_size_x = static_cast<int>(mapsize.x);
+    m_size_z = static_cast<int>(mapsize.z);
+    m_num_tiles_x = (m_size_x + TILE_SIZE - 1) >> TILE_SHIFT;
+    m_num_tiles_z = (m_size_z + TILE_SIZE - 1) >> TILE_SHIFT;
+
+    if (!m_cache_filename.empty() && this->loadCache(textureFilename))
+    {
+        LOG("Loaded landuse map from cache: '" + m_cache_filename + "'");
+        return 0;
+    }
+
     // process the config data and load the buffers finally
     try
     {
@@ -145,13 +175,17 @@ int Landusemap::loadConfig(const Ogre::String& filename)
 
         Ogre::TRect<Ogre::Real> bounds = Forests::TBounds(0, 0, mapsize.x, mapsize.z);
 
-        // now allocate the data buffer to hold pointers to ground models
-        data = new ground_model_t*[(int)(mapsize.x * mapsize.z)];
-        ground_model_t** ptr = data;
-        //std::map < String, int > counters;
-        for (int z = 0; z < mapsize.z; z++)
+        // now allocate the tiles to hold indices of ground models
+        const size_t num_bytes = static_cast<size_t>(m_num_tiles_x * m_num_tiles_z) * TILE_SIZE * TILE_SIZE;
+        m_tiles_buffer.assign(num_bytes + LANDUSE_TILES_ALIGNMENT - 1, 0);
+        uint8_t* tiles = reinterpret_cast<uint8_t*>(
+            (reinterpret_cast<uintptr_t>(m_tiles_buffer.data()) + LANDUSE_TILES_ALIGNMENT - 1) & ~static_cast<uintptr_t>(LANDUSE_TILES_ALIGNMENT - 1));
+
+        std::map<unsigned int, uint8_t> color_indices;
+        bool table_full = false;
+        for (int z = 0; z < m_size_z; z++)
         {
-            for (int x = 0; x < mapsize.x; x++)
+            for (int x = 0; x < m_size_x; x++)
             {
                 unsigned int col = colourMap->getColorAt(x, z, bounds);
                 if (bgr)
@@ -162,15 +196,44 @@ int Landusemap::loadConfig(const Ogre::String& filename)
                     cols |= (col & 0xFF0000) >> 16;
                     col = cols;
                 }
-                String use = usemap[col];
-                //if (use!="")
-                //	counters[use]++;
 
-                // store the pointer to the ground model in the data slot
-                *ptr = App::GetSimTerrain()->GetCollisions()->getGroundModelByString(use);
-                ptr++;
+                auto found = color_indices.find(col);
+                if (found == color_indices.end())
+                {
+                    ground_model_t* gm = App::GetSimTerrain()->GetCollisions()->getGroundModelByString(usemap[col]);
+                    size_t index = std::find(m_ground_models.begin(), m_ground_models.end(), gm) - m_ground_models.begin();
+                    if (index == m_ground_models.size())
+                    {
+                        if (index < MAX_GROUND_MODELS)
+                        {
+                            m_ground_models.push_back(gm);
+                        }
+                        else
+                        {
+                            index = 0;
+                            table_full = true;
+                        }
+                    }
+                    found = color_indices.insert(std::make_pair(col, static_cast<uint8_t>(index))).first;
+                }
+
+                // store the index of the ground model in the tile
+                const int tile = (z >> TILE_SHIFT) * m_num_tiles_x + (x >> TILE_SHIFT);
+                const int texel = ((z & (TILE_SIZE - 1)) << TILE_SHIFT) | (x & (TILE_SIZE - 1));
+                tiles[(tile << (2 * TILE_SHIFT)) | texel] = found->second;
             }
         }
+        m_tiles = tiles;
+
+        if (table_full)
+        {
+            LogFormat("[RoR|Physics] Landuse: more than %d ground models used, the rest falls back to default", MAX_GROUND_MODELS - 1);
+        }
+
+        if (!m_cache_filename.empty())
+        {
+            this->saveCache(textureFilename);
+        }
     }
     catch (Ogre::Exception& oex)
     {
@@ -189,3 +252,107 @@ int Landusemap::loadConfig(const Ogre::String& filename)
 
     return 0;
 }
+
+bool Landusemap::loadCache(std::string const& texture_filename)
+{
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->Open(PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename)))
+    {
+        return false;
+    }
+
+    LandusemapCacheHeader header;
+    if (mapping->GetSize() < sizeof(LandusemapCacheHeader))
+    {
+        return false;
+    }
+    std::memcpy(&header, mapping->GetData(), sizeof(LandusemapCacheHeader));
+    const size_t tiles_size = static_cast<size_t>(m_num_tiles_x * m_num_tiles_z) * TILE_SIZE * TILE_SIZE;
+    if (strncmp(header.signature, LANDUSE_CACHE_SIGNATURE, LANDUSE_CACHE_SIGNATURE_LENGTH) != 0 ||
+        header.file_format_version != LANDUSE_CACHE_FORMAT_VERSION ||
+        header.source_size != m_cache_source_size ||
+        header.source_time != m_cache_source_time ||
+        header.size_x != m_size_x ||
+        header.size_z != m_size_z ||
+        header.num_ground_models == 0 ||
+        header.num_ground_models > MAX_GROUND_MODELS ||
+        header.tiles_offset > mapping->GetSize() ||
+        mapping->GetSize() - header.tiles_offset < tiles_size)
+    {
+        return false;
+    }
+
+    // Texture filename and ground model names (zero-terminated), followed by the tiles
+    const char* pos = mapping->GetData() + sizeof(LandusemapCacheHeader);
+    const char* end = mapping->GetData() + header.tiles_offset;
+    if (static_cast<size_t>(end - pos) <= header.texture_filename_length ||
+        std::string(pos, header.texture_filename_length) != texture_filename)
+    {
+        return false;
+    }
+    pos += header.texture_filename_length + 1;
+
+    std::vector<ground_model_t*> ground_models;
+    for (uint32_t i = 0; i < header.num_ground_models; i++)
+    {
+        const char* name_end = static_cast<const char*>(memchr(pos, '\0', end - pos));
+        if (name_end == nullptr)
+        {
+            return false;
+        }
+        ground_models.push_back((name_end == pos) ? nullptr : App::GetSimTerrain()->GetCollisions()->getGroundModelByString(std::string(pos, name_end)));
+        pos = name_end + 1;
+    }
+
+    m_ground_models = ground_models;
+    m_tiles = reinterpret_cast<const uint8_t*>(mapping->GetData() + header.tiles_offset);
+    m_cache_mapping = mapping;
+    return true;
+}
+
+void Landusemap::saveCache(std::string const& texture_filename)
+{
+    std::vector<char> buf(sizeof(LandusemapCacheHeader));
+    buf.insert(buf.end(), texture_filename.begin(), texture_filename.end());
+    buf.push_back('\0');
+    for (ground_model_t* gm: m_ground_models)
+    {
+        if (gm != nullptr)
+        {
+            buf.insert(buf.end(), gm->name, gm->name + strlen(gm->name));
+        }
+        buf.push_back('\0');
+    }
+    buf.resize((buf.size() + LANDUSE_TILES_ALIGNMENT - 1) & ~(LANDUSE_TILES_ALIGNMENT - 1), '\0');
+
+    LandusemapCacheHeader header;
+    std::memset(&header, 0, sizeof(LandusemapCacheHeader));
+    strncpy(header.signature, LANDUSE_CACHE_SIGNATURE, LANDUSE_CACHE_SIGNATURE_LENGTH - 1);
+    header.file_format_version = LANDUSE_CACHE_FORMAT_VERSION;
+    header.num_ground_models = static_cast<uint32_t>(m_ground_models.size());
+    header.size_x = m_size_x;
+    header.size_z = m_size_z;
+    header.source_size = m_cache_source_size;
+    header.source_time = m_cache_source_time;
+    header.texture_filename_length = static_cast<uint32_t>(texture_filename.size());
+    header.tiles_offset = static_cast<uint32_t>(buf.size());
+    std::memcpy(buf.data(), &header, sizeof(LandusemapCacheHeader));
+
+    // Write to a temporary file and swap it in when complete
+    const size_t tiles_size = static_cast<size_t>(m_num_tiles_x * m_num_tiles_z) * TILE_SIZE * TILE_SIZE;
+    const std::string path = PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename);
+    FILE* file = fopen((path + ".tmp").c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+    const bool written = (fwrite(buf.data(), 1, buf.size(), file) == buf.size()) &&
+                         (fwrite(m_tiles, 1, tiles_size, file) == tiles_size);
+    fclose(file);
+    std::remove(path.c_str());
+    if (!written || std::rename((path + ".tmp").c_str(), path.c_str()) != 0)
+    {
+        std::remove((path + ".tmp").c_str());
+        LOG("[RoR|Physics] Landuse: failed to write cache file '" + m_cache_filename + "'");
+    }
+}
@@ -25,21 +25,61 @@
 #include "Application.h"
 #include "SimData.h"
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace RoR {
 
+class MappedFile;
+
+/// Ground model per terrain texel, stored as 8-bit indices into a small table of ground models.
+/// Texels are grouped in 64x64 tiles (4KB each) so that nearby lookups stay within a few cache lines.
 class Landusemap : public ZeroedMemoryAllocator
 {
 public:
 
-    Landusemap(Ogre::String cfgfilename);
+    /// @param cache_filename Preconverted map in the cache directory; empty = no caching.
+    /// @param source_size/source_time Fingerprint of the terrain ZIP/file, validates the cache.
+    Landusemap(Ogre::String cfgfilename, std::string const& cache_filename = "", uint64_t source_size = 0, int64_t source_time = 0);
     ~Landusemap();
 
-    ground_model_t* getGroundModelAt(int x, int z);
+    ground_model_t* getGroundModelAt(int x, int z)
+    {
+        if (!m_tiles)
+            return nullptr;
+
+        // we return the default ground model if we are not anymore in this map
+        if (x < 0 || x >= m_size_x || z < 0 || z >= m_size_z)
+            return default_ground_model;
+
+        const int tile = (z >> TILE_SHIFT) * m_num_tiles_x + (x >> TILE_SHIFT);
+        const int texel = ((z & (TILE_SIZE - 1)) << TILE_SHIFT) | (x & (TILE_SIZE - 1));
+        return m_ground_models[m_tiles[(tile << (2 * TILE_SHIFT)) | texel]];
+    }
+
     int loadConfig(const Ogre::String& filename);
 
 protected:
 
-    ground_model_t** data;
+    static const int TILE_SHIFT = 6; //!< 64x64 texels per tile
+    static const int TILE_SIZE = 1 << TILE_SHIFT;
+    static const int MAX_GROUND_MODELS = 256;
+
+    bool loadCache(std::string const& texture_filename);
+    void saveCache(std::string const& texture_filename);
+
+    std::vector<ground_model_t*> m_ground_models; //!< Index 0 = none (nullptr)
+    const uint8_t*               m_tiles;         //!< Points into `m_tiles_buffer` or the mapped cache file
+    std::vector<uint8_t>         m_tiles_buffer;
+    std::shared_ptr<MappedFile>  m_cache_mapping;
+    std::string                  m_cache_filename;
+    uint64_t                     m_cache_source_size;
+    int64_t                      m_cache_source_time;
+    int                          m_num_tiles_x;
+    int                          m_num_tiles_z;
+    int                          m_size_x;
+    int                          m_size_z;
     ground_model_t* default_ground_model;
 
     Ogre::Vector3 mapsize;
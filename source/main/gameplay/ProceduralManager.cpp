@@ -22,10 +22,13 @@
 
 #include "Application.h"
 #include "Road2.h"
+#include "ThreadPool.h"
 
 using namespace Ogre;
 using namespace RoR;
 
+static const int SEGMENTS_PER_TASK = 32;
+
 ProceduralManager::~ProceduralManager()
 {
     for (ProceduralObject& po : pObjects)
@@ -45,30 +48,53 @@ int ProceduralManager::deleteObject(ProceduralObject& po)
     return 0;
 }
 
-int ProceduralManager::updateObject(ProceduralObject& po)
+void ProceduralManager::addObjects(std::vector<ProceduralObject> const& objects)
 {
-    if (po.road)
-        deleteObject(po);
-    // create new road2 object
-    po.road = new Road2((int)pObjects.size());
-    // In diagnostic mode, disable collisions (speeds up terrain loading)
-    po.road->setCollisionEnabled(!App::diag_terrn_log_roads->GetBool());
+    const size_t first_new = pObjects.size();
+    std::vector<std::pair<Road2*, int>> segments; // Of all new roads, so that small roads share tasks
+    for (ProceduralObject const& obj : objects)
+    {
+        ProceduralObject po = obj;
+        // create new road2 object
+        po.road = new Road2((int)pObjects.size());
+        // In diagnostic mode, disable collisions (speeds up terrain loading)
+        po.road->setCollisionEnabled(!App::diag_terrn_log_roads->GetBool());
 
-    std::vector<ProceduralPoint>::iterator it;
-    for (it = po.points.begin(); it != po.points.end(); it++)
+        std::vector<ProceduralPoint>::iterator it;
+        for (it = po.points.begin(); it != po.points.end(); it++)
+        {
+            ProceduralPoint pp = *it;
+            po.road->addBlock(pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
+        }
+
+        const int num_segments = po.road->prepareSegments();
+        for (int i = 0; i < num_segments; i++)
+        {
+            segments.push_back(std::make_pair(po.road, i));
+        }
+        pObjects.push_back(po);
+    }
+
+    // Generate geometry on worker threads
+    std::vector<std::function<void()>> tasks;
+    for (size_t start = 0; start < segments.size(); start += SEGMENTS_PER_TASK)
     {
-        ProceduralPoint pp = *it;
-        po.road->addBlock(pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
+        const size_t end = std::min(start + SEGMENTS_PER_TASK, segments.size());
+        tasks.push_back([&segments, start, end]()
+            {
+                for (size_t i = start; i < end; i++)
+                {
+                    segments[i].first->generateSegment(segments[i].second);
+                }
+            });
     }
-    po.road->finish();
-    return 0;
-}
+    App::GetThreadPool()->Parallelize(tasks);
 
-int ProceduralManager::addObject(ProceduralObject& po)
-{
-    updateObject(po);
-    pObjects.push_back(po);
-    return 0;
+    // Collision and meshes on main thread, in order of objects (keeps the collision cache replay order)
+    for (size_t i = first_new; i < pObjects.size(); i++)
+    {
+        pObjects[i].road->finish();
+    }
 }
 
 void ProceduralManager::logDiagnostics()
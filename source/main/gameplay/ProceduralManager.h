@@ -48,14 +48,14 @@ class ProceduralManager
 public:
     ~ProceduralManager();
 
-    int  addObject(ProceduralObject& po);
+    /// Builds the roads; segments of all of them are generated on the thread pool in one batch.
+    void addObjects(std::vector<ProceduralObject> const& objects);
 
     int  deleteObject(ProceduralObject& po);
 
     void logDiagnostics();
 
 private:
-    int updateObject(ProceduralObject& po);
 
     std::vector<ProceduralObject> pObjects;
 };
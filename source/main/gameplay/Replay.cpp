@@ -24,6 +24,7 @@
 #include "Actor.h"
 #include "ActorManager.h"
 #include "GameContext.h"
+#include "GfxActor.h"
 #include "GUIManager.h"
 #include "InputEngine.h"
 #include "Language.h"
@@ -219,6 +220,7 @@ void Replay::replayStepActor()
         node_simple_t* nbuff = (node_simple_t *)this->getReadBuffer(ar_replay_pos, 0, time);
         if (nbuff)
         {
+            m_actor->GetGfxActor()->DiscardSimNodeBackBuffer();
             for (int i = 0; i < m_actor->ar_num_nodes; i++)
             {
                 m_actor->ar_nodes[i].AbsPosition = nbuff[i].position;
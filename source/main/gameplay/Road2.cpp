@@ -29,11 +29,13 @@ using namespace Ogre;
 using namespace RoR;
 
 Road2::Road2(int id) :
-    first(true)
-    , mid(id)
+    mainsub(0)
     , snode(0)
-    , tricount(0)
-    , vertexcount(0)
+    , m_pillar_counter(0)
+    , m_gm_concrete(0)
+    , m_gm_asphalt(0)
+    , mid(id)
+    , collision(false)
 {
     msh.setNull();
 }
@@ -55,215 +57,265 @@ Road2::~Road2()
     }
 }
 
+void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
+{
+    Block b;
+    b.pos = pos;
+    b.rot = rot;
+    b.type = type;
+    b.width = width;
+    b.bwidth = bwidth;
+    b.bheight = bheight;
+    b.pillartype = pillartype;
+    this->resolveBlock(b, m_blocks.empty());
+
+    // Pillar counting runs through the whole road, so it's done here rather than per segment
+    int pillar_index = 0;
+    if (!m_blocks.empty() && (b.type == ROAD_BRIDGE || b.type == ROAD_MONORAIL) && b.pillartype > 0)
+    {
+        pillar_index = ++m_pillar_counter;
+    }
+    m_blocks.push_back(b);
+    m_pillar_indices.push_back(pillar_index);
+}
+
+int Road2::prepareSegments()
+{
+    if (collision)
+    {
+        m_gm_concrete = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        m_gm_asphalt = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("asphalt");
+    }
+
+    const int num_segments = (m_blocks.empty()) ? 0 : ((int)m_blocks.size() + 1);
+    m_segments.resize(num_segments);
+    return num_segments;
+}
+
 void Road2::finish()
 {
-    Vector3 pts[8];
-    computePoints(pts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
-    addQuad(pts[7], pts[6], pts[5], pts[4], TEXFIT_NONE, lastpos, lastpos, lastwidth);
-    addQuad(pts[7], pts[4], pts[3], pts[0], TEXFIT_NONE, lastpos, lastpos, lastwidth);
-    addQuad(pts[3], pts[2], pts[1], pts[0], TEXFIT_NONE, lastpos, lastpos, lastwidth);
+    if (App::diag_terrn_log_roads->GetBool())
+    {
+        for (size_t i = 0; i < m_blocks.size(); i++)
+        {
+            this->logBlock(m_blocks[i], m_segments[i]);
+        }
+    }
 
-    createMesh();
-    String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
-    String mesh_name = String("RoadSystem-").append(StringConverter::toString(mid));
-    Entity* ec = App::GetGfxScene()->GetSceneManager()->createEntity(entity_name, mesh_name);
-    snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
-    snode->attachObject(ec);
+    this->createMesh();
 }
 
-void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
+void Road2::resolveBlock(Block& b, bool first)
 {
-    if (type == ROAD_AUTOMATIC)
+    if (b.type == ROAD_AUTOMATIC)
     {
-        width = 10.0;
-        bwidth = 1.4;
-        bheight = 0.2;
+        b.width = 10.0;
+        b.bwidth = 1.4;
+        b.bheight = 0.2;
         //define type
-        Vector3 leftv = pos + rot * Vector3(0, 0, bwidth + width / 2.0);
-        Vector3 rightv = pos + rot * Vector3(0, 0, -bwidth - width / 2.0);
+        Vector3 leftv = b.pos + b.rot * Vector3(0, 0, b.bwidth + b.width / 2.0);
+        Vector3 rightv = b.pos + b.rot * Vector3(0, 0, -b.bwidth - b.width / 2.0);
         float dleft = leftv.y - RoR::App::GetSimTerrain()->GetHeightAt(leftv.x, leftv.z);
         float dright = rightv.y - RoR::App::GetSimTerrain()->GetHeightAt(rightv.x, rightv.z);
-        if (dleft < bheight + 0.1 && dright < bheight + 0.1)
-            type = ROAD_FLAT;
-        if (dleft < bheight + 0.1 && dright >= bheight + 0.1 && dright < 4.0)
-            type = ROAD_LEFT;
-        if (dleft >= bheight + 0.1 && dleft < 4.0 && dright < bheight + 0.1)
-            type = ROAD_RIGHT;
-        if (dleft >= bheight + 0.1 && dleft < 4.0 && dright >= bheight + 0.1 && dright < 4.0)
-            type = ROAD_BOTH;
-        if (type == ROAD_AUTOMATIC)
-            type = ROAD_BRIDGE;
-        if (type != ROAD_FLAT)
+        if (dleft < b.bheight + 0.1 && dright < b.bheight + 0.1)
+            b.type = ROAD_FLAT;
+        if (dleft < b.bheight + 0.1 && dright >= b.bheight + 0.1 && dright < 4.0)
+            b.type = ROAD_LEFT;
+        if (dleft >= b.bheight + 0.1 && dleft < 4.0 && dright < b.bheight + 0.1)
+            b.type = ROAD_RIGHT;
+        if (dleft >= b.bheight + 0.1 && dleft < 4.0 && dright >= b.bheight + 0.1 && dright < 4.0)
+            b.type = ROAD_BOTH;
+        if (b.type == ROAD_AUTOMATIC)
+            b.type = ROAD_BRIDGE;
+        if (b.type != ROAD_FLAT)
         {
-            width = 10.0;
-            bwidth = 0.4;
-            bheight = 0.5;
+            b.width = 10.0;
+            b.bwidth = 0.4;
+            b.bheight = 0.5;
         };
     }
 
-    Vector3 pts[8];
-    if (!first)
+    if (!first && b.type == ROAD_MONORAIL)
+        b.pos.y += 2;
+}
+
+void Road2::generateSegment(int index)
+{
+    Segment& seg = m_segments[index];
+    Vector3* pts = seg.pts;
+    if (index == 0)
     {
-        Vector3 lpts[8];
-        if (type == ROAD_MONORAIL)
-            pos.y += 2;
+        Block const& b = m_blocks[0];
+        computePoints(pts, b.pos, b.rot, b.type, b.width, b.bwidth, b.bheight);
+        addQuad(seg, pts[0], pts[1], pts[2], pts[3], TEXFIT_NONE, b.pos, b.pos, b.width);
+        addQuad(seg, pts[0], pts[3], pts[4], pts[7], TEXFIT_NONE, b.pos, b.pos, b.width);
+        addQuad(seg, pts[4], pts[5], pts[6], pts[7], TEXFIT_NONE, b.pos, b.pos, b.width);
+    }
+    else if (index == (int)m_blocks.size())
+    {
+        Block const& last = m_blocks.back();
+        computePoints(pts, last.pos, last.rot, last.type, last.width, last.bwidth, last.bheight);
+        addQuad(seg, pts[7], pts[6], pts[5], pts[4], TEXFIT_NONE, last.pos, last.pos, last.width);
+        addQuad(seg, pts[7], pts[4], pts[3], pts[0], TEXFIT_NONE, last.pos, last.pos, last.width);
+        addQuad(seg, pts[3], pts[2], pts[1], pts[0], TEXFIT_NONE, last.pos, last.pos, last.width);
+    }
+    else
+    {
+        Block const& cur = m_blocks[index];
+        Block const& last = m_blocks[index - 1];
+        const Vector3 pos = cur.pos;
+        const Vector3 lastpos = last.pos;
+        const float width = cur.width;
+        const int type = cur.type;
+        const int lasttype = last.type;
 
-        computePoints(pts, pos, rot, type, width, bwidth, bheight);
-        computePoints(lpts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
+        Vector3 lpts[8];
+        computePoints(pts, pos, cur.rot, type, width, cur.bwidth, cur.bheight);
+        computePoints(lpts, lastpos, last.rot, lasttype, last.width, last.bwidth, last.bheight);
 
         //tarmac
         if (type == ROAD_MONORAIL)
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TEXFIT_CONCRETETOP, pos, lastpos, width);
+            addQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TEXFIT_CONCRETETOP, pos, lastpos, width);
         else
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TEXFIT_ROAD, pos, lastpos, width);
+            addQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TEXFIT_ROAD, pos, lastpos, width);
 
         if (type == ROAD_FLAT && lasttype == ROAD_FLAT)
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TEXFIT_ROADS3, pos, lastpos, width);
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TEXFIT_ROADS2, pos, lastpos, width);
+            addQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TEXFIT_ROADS3, pos, lastpos, width);
+            addQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TEXFIT_ROADS2, pos, lastpos, width);
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TEXFIT_ROADS4, pos, lastpos, width);
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TEXFIT_ROADS1, pos, lastpos, width);
+            addQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TEXFIT_ROADS4, pos, lastpos, width);
+            addQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TEXFIT_ROADS1, pos, lastpos, width);
         }
         else
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TEXFIT_CONCRETEWALLI, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TEXFIT_CONCRETEWALLI, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
+            addQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TEXFIT_CONCRETEWALLI, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
+            addQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TEXFIT_CONCRETEWALLI, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TEXFIT_CONCRETETOP, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TEXFIT_CONCRETETOP, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
+            addQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TEXFIT_CONCRETETOP, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
+            addQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TEXFIT_CONCRETETOP, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
         }
         if (type == ROAD_BRIDGE || lasttype == ROAD_BRIDGE || type == ROAD_MONORAIL || lasttype == ROAD_MONORAIL)
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TEXFIT_CONCRETEWALL, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TEXFIT_CONCRETEWALL, pos, lastpos, width);
+            addQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TEXFIT_CONCRETEWALL, pos, lastpos, width);
+            addQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TEXFIT_CONCRETEWALL, pos, lastpos, width);
             //underside - we flip the underside so it folds gracefully with the top
-            addQuad(pts[0], lpts[0], lpts[7], pts[7], TEXFIT_CONCRETEUNDER, pos, lastpos, width, true);
+            addQuad(seg, pts[0], lpts[0], lpts[7], pts[7], TEXFIT_CONCRETEUNDER, pos, lastpos, width, true);
         }
         else
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TEXFIT_BRICKWALL, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TEXFIT_BRICKWALL, pos, lastpos, width);
+            addQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TEXFIT_BRICKWALL, pos, lastpos, width);
+            addQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TEXFIT_BRICKWALL, pos, lastpos, width);
         }
-        if ((type == ROAD_BRIDGE || type == ROAD_MONORAIL) && pillartype > 0)
+        if ((type == ROAD_BRIDGE || type == ROAD_MONORAIL) && cur.pillartype > 0)
         {
-            /* this is the basic bridge pillar mod.
-             * it will create on pillar for each segment!
-             * @todo: create only a few pillars instead of so much!
-             */
-            // construct the pillars
-            Vector3 leftv = pos + rot * Vector3(0, 0, bwidth + width / 2.0);
-            Vector3 rightv = pos + rot * Vector3(0, 0, -bwidth - width / 2.0);
-            Vector3 middle = lpts[0] - ((lpts[0] + (pts[1] - lpts[0]) / 2) -
-                (lpts[7] + (pts[6] - lpts[7]) / 2)) * 0.5;
-            float heightleft = RoR::App::GetSimTerrain()->GetHeightAt(leftv.x, leftv.z);
-            float heightright = RoR::App::GetSimTerrain()->GetHeightAt(rightv.x, rightv.z);
-            float heightmiddle = RoR::App::GetSimTerrain()->GetHeightAt(middle.x, middle.z);
-
-            bool builtpillars = true;
-
-            float sidefactor = 0.5; // 0.5 = middle
-            // only re-position short pillars! (< 10 meters)
-            // so big bridge pillars do not get repositioned
-            if (pos.y - heightmiddle < 10)
-            {
-                if (heightleft >= heightright)
-                    sidefactor = 0.8;
-                else
-                    sidefactor = 0.2;
-            }
+            this->generatePillar(seg, pts, lpts, cur, last, m_pillar_indices[index]);
+        }
+    }
+}
 
-            static int pillarcounter = 0;
-            pillarcounter++;
+void Road2::generatePillar(Segment& seg, Vector3* pts, Vector3* lpts, Block const& cur, Block const& last, int pillar_index)
+{
+    /* this is the basic bridge pillar mod.
+     * it will create on pillar for each segment!
+     * @todo: create only a few pillars instead of so much!
+     */
+    const Vector3 pos = cur.pos;
+    const Vector3 lastpos = last.pos;
+    // construct the pillars
+    Vector3 leftv = pos + cur.rot * Vector3(0, 0, cur.bwidth + cur.width / 2.0);
+    Vector3 rightv = pos + cur.rot * Vector3(0, 0, -cur.bwidth - cur.width / 2.0);
+    Vector3 middle = lpts[0] - ((lpts[0] + (pts[1] - lpts[0]) / 2) -
+        (lpts[7] + (pts[6] - lpts[7]) / 2)) * 0.5;
+    float heightleft = RoR::App::GetSimTerrain()->GetHeightAt(leftv.x, leftv.z);
+    float heightright = RoR::App::GetSimTerrain()->GetHeightAt(rightv.x, rightv.z);
+    float heightmiddle = RoR::App::GetSimTerrain()->GetHeightAt(middle.x, middle.z);
+
+    bool builtpillars = true;
+
+    float sidefactor = 0.5; // 0.5 = middle
+    // only re-position short pillars! (< 10 meters)
+    // so big bridge pillars do not get repositioned
+    if (pos.y - heightmiddle < 10)
+    {
+        if (heightleft >= heightright)
+            sidefactor = 0.8;
+        else
+            sidefactor = 0.2;
+    }
 
-            if (pillartype == 2)
-            {
-                // always in the middle
-                sidefactor = 0.5;
-                // only build every fifth pillar
-                if (pillarcounter % 5)
-                    builtpillars = false;
-            }
+    if (cur.pillartype == 2)
+    {
+        // always in the middle
+        sidefactor = 0.5;
+        // only build every fifth pillar
+        if (pillar_index % 5)
+            builtpillars = false;
+    }
 
-            middle = lpts[0] - ((lpts[0] + (pts[1] - lpts[0]) / 2) -
-                (lpts[7] + (pts[6] - lpts[7]) / 2)) * sidefactor;
-            float len = middle.y - RoR::App::GetSimTerrain()->GetHeightAt(middle.x, middle.z) + 5;
-            float width2 = len / 30;
+    middle = lpts[0] - ((lpts[0] + (pts[1] - lpts[0]) / 2) -
+        (lpts[7] + (pts[6] - lpts[7]) / 2)) * sidefactor;
+    float len = middle.y - RoR::App::GetSimTerrain()->GetHeightAt(middle.x, middle.z) + 5;
+    float width2 = len / 30;
 
-            if (pillartype == 2 && len > 20)
-            // no over-long pillars
-                builtpillars = false;
+    if (cur.pillartype == 2 && len > 20)
+    // no over-long pillars
+        builtpillars = false;
 
-            // do not draw too small pillars, the bridge may hold without them ;)
-            if (width2 > 5)
-                width2 = 5;
+    // do not draw too small pillars, the bridge may hold without them ;)
+    if (width2 > 5)
+        width2 = 5;
 
-            if (pillartype == 2)
-                width2 = 0.2;
+    if (cur.pillartype == 2)
+        width2 = 0.2;
 
-            if (width2 >= 0.2 && builtpillars)
-            {
-                //sides
-                addQuad(middle + Vector3(-width2, -len, -width2),
-                    middle + Vector3(-width2, 0, -width2),
-                    middle + Vector3(width2, 0, -width2),
-                    middle + Vector3(width2, -len, -width2),
-                    TEXFIT_CONCRETETOP, pos, lastpos, width2);
-
-                addQuad(middle + Vector3(width2, -len, width2),
-                    middle + Vector3(width2, 0, width2),
-                    middle + Vector3(-width2, 0, width2),
-                    middle + Vector3(-width2, -len, width2),
-                    TEXFIT_CONCRETETOP, pos, lastpos, width2);
-
-                addQuad(middle + Vector3(-width2, -len, width2),
-                    middle + Vector3(-width2, 0, width2),
-                    middle + Vector3(-width2, 0, -width2),
-                    middle + Vector3(-width2, -len, -width2),
-                    TEXFIT_CONCRETETOP, pos, lastpos, width2);
-
-                addQuad(middle + Vector3(width2, -len, -width2),
-                    middle + Vector3(width2, 0, -width2),
-                    middle + Vector3(width2, 0, width2),
-                    middle + Vector3(width2, -len, width2),
-                    TEXFIT_CONCRETETOP, pos, lastpos, width2);
-            }
-        }
-    }
-    else
+    if (width2 >= 0.2 && builtpillars)
     {
-        first = false;
-        computePoints(pts, pos, rot, type, width, bwidth, bheight);
-        addQuad(pts[0], pts[1], pts[2], pts[3], TEXFIT_NONE, pos, pos, width);
-        addQuad(pts[0], pts[3], pts[4], pts[7], TEXFIT_NONE, pos, pos, width);
-        addQuad(pts[4], pts[5], pts[6], pts[7], TEXFIT_NONE, pos, pos, width);
+        //sides
+        addQuad(seg, middle + Vector3(-width2, -len, -width2),
+            middle + Vector3(-width2, 0, -width2),
+            middle + Vector3(width2, 0, -width2),
+            middle + Vector3(width2, -len, -width2),
+            TEXFIT_CONCRETETOP, pos, lastpos, width2);
+
+        addQuad(seg, middle + Vector3(width2, -len, width2),
+            middle + Vector3(width2, 0, width2),
+            middle + Vector3(-width2, 0, width2),
+            middle + Vector3(-width2, -len, width2),
+            TEXFIT_CONCRETETOP, pos, lastpos, width2);
+
+        addQuad(seg, middle + Vector3(-width2, -len, width2),
+            middle + Vector3(-width2, 0, width2),
+            middle + Vector3(-width2, 0, -width2),
+            middle + Vector3(-width2, -len, -width2),
+            TEXFIT_CONCRETETOP, pos, lastpos, width2);
+
+        addQuad(seg, middle + Vector3(width2, -len, -width2),
+            middle + Vector3(width2, 0, -width2),
+            middle + Vector3(width2, 0, width2),
+            middle + Vector3(width2, -len, width2),
+            TEXFIT_CONCRETETOP, pos, lastpos, width2);
     }
-    lastpos = pos;
-    lastrot = rot;
-    lastwidth = width;
-    lastbwidth = bwidth;
-    lastbheight = bheight;
-    lasttype = type;
+}
 
-    if (App::diag_terrn_log_roads->GetBool())
+void Road2::logBlock(Block const& b, Segment const& seg)
+{
+    Str<2000> msg; msg << "[RoR] Road Block |";
+    msg << " pos=(" << b.pos.x << " " << b.pos.y << " " << b.pos.z << ")";
+    msg << " rot=(" << b.rot.x << " " << b.rot.y << " " << b.rot.z << ")";
+    msg << " width=" << b.width;
+    msg << " bwidth=" << b.bwidth;
+    msg << " bheight=" << b.bheight;
+    msg << " type=" << b.type;
+    for (int i = 0; i < 8; ++i)
     {
-        Str<2000> msg; msg << "[RoR] Road Block |";
-        msg << " pos=(" << pos.x << " " << pos.y << " " << pos.z << ")";
-        msg << " rot=(" << rot.x << " " << rot.y << " " << rot.z << ")";
-        msg << " width=" << width;
-        msg << " bwidth=" << bwidth;
-        msg << " bheight=" << bheight;
-        msg << " type=" << type;
-        for (int i = 0; i < 8; ++i)
-        {
-            msg << "\n\t Point#" << i << ": " << pts[i].x << " " << pts[i].y << " " << pts[i].z;
-        }
-        Log(msg.ToCStr());
+        msg << "\n\t Point#" << i << ": " << seg.pts[i].x << " " << seg.pts[i].y << " " << seg.pts[i].z;
     }
+    Log(msg.ToCStr());
 }
 
 void Road2::computePoints(Vector3* pts, Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight)
@@ -348,49 +400,67 @@ inline Vector3 Road2::baseOf(Vector3 p)
     return Vector3(p.x, y, p.z);
 }
 
-void Road2::addQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, Vector3 pos, Vector3 lastpos, float width, bool flip)
+void Road2::addQuad(Segment& seg, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, Vector3 pos, Vector3 lastpos, float width, bool flip)
 {
-    if (vertexcount + 3 >= MAX_VERTEX || tricount * 3 + 3 + 2 >= MAX_TRIS * 3)
-        return;
     Vector2 texf[4];
     textureFit(p1, p2, p3, p4, texfit, texf, pos, lastpos, width);
     //vertexes
-    vertex[vertexcount] = p1;
-    tex[vertexcount] = texf[0];
-    vertex[vertexcount + 1] = p2;
-    tex[vertexcount + 1] = texf[1];
-    vertex[vertexcount + 2] = p3;
-    tex[vertexcount + 2] = texf[2];
-    vertex[vertexcount + 3] = p4;
-    tex[vertexcount + 3] = texf[3];
+    const uint16_t vertexcount = (uint16_t)seg.vertices.size();
+    seg.vertices.push_back(p1);
+    seg.vertices.push_back(p2);
+    seg.vertices.push_back(p3);
+    seg.vertices.push_back(p4);
+    seg.texcoords.insert(seg.texcoords.end(), texf, texf + 4);
     //tris
+    uint16_t tris[6];
     if (flip)
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 3;
-        tris[tricount * 3 + 3] = vertexcount + 1;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        tris[0] = vertexcount;
+        tris[1] = vertexcount + 1;
+        tris[2] = vertexcount + 3;
+        tris[3] = vertexcount + 1;
+        tris[4] = vertexcount + 2;
+        tris[5] = vertexcount + 3;
     }
     else
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 2;
-        tris[tricount * 3 + 3] = vertexcount;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        tris[0] = vertexcount;
+        tris[1] = vertexcount + 1;
+        tris[2] = vertexcount + 2;
+        tris[3] = vertexcount;
+        tris[4] = vertexcount + 2;
+        tris[5] = vertexcount + 3;
+    }
+    seg.indices.insert(seg.indices.end(), tris, tris + 6);
+    //normals - quads don't share vertices, so only this quad's tris contribute
+    seg.normals.resize(seg.vertices.size(), Vector3::ZERO);
+    for (int i = 0; i < 6; i += 3)
+    {
+        Vector3 v1 = seg.vertices[tris[i + 1]] - seg.vertices[tris[i]];
+        Vector3 v2 = seg.vertices[tris[i + 2]] - seg.vertices[tris[i]];
+        v1 = v1.crossProduct(v2);
+        v1.normalise();
+        seg.normals[tris[i]] += v1;
+        seg.normals[tris[i + 1]] += v1;
+        seg.normals[tris[i + 2]] += v1;
+    }
+    for (int i = vertexcount; i < vertexcount + 4; i++)
+    {
+        seg.normals[i].normalise();
     }
     if (collision)
     {
-        ground_model_t* gm = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        CollisionQuad quad;
+        quad.p1 = p1;
+        quad.p2 = p2;
+        quad.p3 = p3;
+        quad.p4 = p4;
+        quad.gm = m_gm_concrete;
         if (texfit == TEXFIT_ROAD || texfit == TEXFIT_ROADS1 || texfit == TEXFIT_ROADS2 || texfit == TEXFIT_ROADS3 || texfit == TEXFIT_ROADS4)
-            gm = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("asphalt");
-        addCollisionQuad(p1, p2, p3, p4, gm, flip);
+            quad.gm = m_gm_asphalt;
+        quad.flip = flip;
+        seg.coll_quads.push_back(quad);
     }
-    tricount += 2;
-    vertexcount += 4;
 }
 
 void Road2::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, Vector2* texc, Vector3 pos, Vector3 lastpos, float width)
@@ -528,39 +598,85 @@ void Road2::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfi
         texc[i] = Vector2(0, 0);
 }
 
-void Road2::addCollisionQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, ground_model_t* gm, bool flip)
+void Road2::registerCollision(Segment& seg)
 {
-    int triID = 0;
-    if (flip)
+    for (int i = 0; i < seg.num_quads_used; i++)
     {
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p2, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+        CollisionQuad const& q = seg.coll_quads[i];
+        int triID = 0;
+        if (q.flip)
+        {
+            triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p2, q.p4, q.gm);
+            if (triID >= 0)
+                registeredCollTris.push_back(triID);
 
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p4, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
-    }
-    else
-    {
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+            triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(q.p4, q.p2, q.p3, q.gm);
+            if (triID >= 0)
+                registeredCollTris.push_back(triID);
+        }
+        else
+        {
+            triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p2, q.p3, q.gm);
+            if (triID >= 0)
+                registeredCollTris.push_back(triID);
 
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p3, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+            triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p3, q.p4, q.gm);
+            if (triID >= 0)
+                registeredCollTris.push_back(triID);
+        }
     }
 }
 
 void Road2::createMesh()
 {
+    // Count quads which fit the buffers (the rest is dropped) and register their collision, in segment order
+    int vertexcount = 0;
+    int tricount = 0;
+    for (Segment& seg : m_segments)
+    {
+        const int num_quads = (int)seg.vertices.size() / 4;
+        while (seg.num_quads_used < num_quads && vertexcount + 3 < (int)MAX_VERTEX && tricount * 3 + 3 + 2 < (int)MAX_TRIS * 3)
+        {
+            seg.num_quads_used++;
+            vertexcount += 4;
+            tricount += 2;
+        }
+        if (collision)
+        {
+            this->registerCollision(seg);
+        }
+    }
+
+    if (vertexcount == 0)
+    {
+        return;
+    }
+
+    /// Merge the segments
     AxisAlignedBox aab;
-    union
+    std::vector<CoVertice_t> covertices(vertexcount);
+    std::vector<uint16_t> tris(tricount * 3);
+    int vertex_pos = 0;
+    int index_pos = 0;
+    for (Segment const& seg : m_segments)
     {
-        float* vertices;
-        CoVertice_t* covertices;
-    };
+        const int num_vertices = seg.num_quads_used * 4;
+        for (int i = 0; i < num_vertices; i++)
+        {
+            covertices[vertex_pos + i].vertex = seg.vertices[i];
+            covertices[vertex_pos + i].normal = seg.normals[i];
+            covertices[vertex_pos + i].texcoord = seg.texcoords[i];
+            aab.merge(seg.vertices[i]);
+        }
+        const int num_indices = seg.num_quads_used * 6;
+        for (int i = 0; i < num_indices; i++)
+        {
+            tris[index_pos + i] = (uint16_t)(vertex_pos + seg.indices[i]);
+        }
+        vertex_pos += num_vertices;
+        index_pos += num_indices;
+    }
+
     /// Create the mesh via the MeshManager
     Ogre::String mesh_name = Ogre::String("RoadSystem-").append(Ogre::StringConverter::toString(mid));
     msh = MeshManager::getSingleton().createManual(mesh_name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
@@ -568,41 +684,6 @@ void Road2::createMesh()
     mainsub = msh->createSubMesh();
     mainsub->setMaterialName("road2");
 
-    /// Define the vertices
-    size_t vbufCount = (2 * 3 + 2) * vertexcount;
-    vertices = (float*)malloc(vbufCount * sizeof(float));
-    int i;
-    //fill values
-    for (i = 0; i < vertexcount; i++)
-    {
-        covertices[i].texcoord = tex[i];
-        covertices[i].vertex = vertex[i];
-        //normals are computed later
-        covertices[i].normal = Vector3::ZERO;
-        aab.merge(vertex[i]);
-    }
-
-    /// Define triangles
-    size_t ibufCount = 3 * tricount;
-
-    //compute normals
-    for (i = 0; i < tricount && i * 3 + 2 < MAX_TRIS * 3; i++)
-    {
-        Vector3 v1, v2;
-        v1 = covertices[tris[i * 3 + 1]].vertex - covertices[tris[i * 3]].vertex;
-        v2 = covertices[tris[i * 3 + 2]].vertex - covertices[tris[i * 3]].vertex;
-        v1 = v1.crossProduct(v2);
-        v1.normalise();
-        covertices[tris[i * 3]].normal += v1;
-        covertices[tris[i * 3 + 1]].normal += v1;
-        covertices[tris[i * 3 + 2]].normal += v1;
-    }
-    //normalize
-    for (i = 0; i < vertexcount; i++)
-    {
-        covertices[i].normal.normalise();
-    }
-
     /// Create vertex data structure for vertices shared between sub meshes
     msh->sharedVertexData = new VertexData();
     msh->sharedVertexData->vertexCount = vertexcount;
@@ -618,13 +699,13 @@ void Road2::createMesh()
     offset += VertexElement::getTypeSize(VET_FLOAT2);
 
     /// Allocate vertex buffer of the requested number of vertices (vertexCount)
-    /// and bytes per vertex (offset)
+    /// and bytes per vertex
     HardwareVertexBufferSharedPtr vbuf =
         HardwareBufferManager::getSingleton().createVertexBuffer(
-            offset, msh->sharedVertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            sizeof(CoVertice_t), msh->sharedVertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
 
     /// Upload the vertex data to the card
-    vbuf->writeData(0, vbuf->getSizeInBytes(), vertices, true);
+    vbuf->writeData(0, vbuf->getSizeInBytes(), covertices.data(), true);
 
     /// Set vertex buffer binding so buffer 0 is bound to our vertex buffer
     VertexBufferBinding* bind = msh->sharedVertexData->vertexBufferBinding;
@@ -632,6 +713,7 @@ void Road2::createMesh()
 
     //for the face
     /// Allocate index buffer of the requested number of vertices (ibufCount)
+    size_t ibufCount = 3 * tricount;
     HardwareIndexBufferSharedPtr ibuf = HardwareBufferManager::getSingleton().
         createIndexBuffer(
             HardwareIndexBuffer::IT_16BIT,
@@ -639,7 +721,7 @@ void Road2::createMesh()
             HardwareBuffer::HBU_STATIC_WRITE_ONLY);
 
     /// Upload the index data to the card
-    ibuf->writeData(0, ibuf->getSizeInBytes(), tris, true);
+    ibuf->writeData(0, ibuf->getSizeInBytes(), tris.data(), true);
 
     /// Set parameters of the submesh
     mainsub->useSharedVertices = true;
@@ -652,5 +734,8 @@ void Road2::createMesh()
     /// Notify Mesh object that it has been loaded
     msh->load();
 
-    free(vertices);
-};
+    String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
+    Entity* ec = App::GetGfxScene()->GetSceneManager()->createEntity(entity_name, msh->getName());
+    snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
+    snode->attachObject(ec);
+}
@@ -24,6 +24,9 @@
 
 #include "Application.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace RoR {
 
 // dynamic roads
@@ -35,13 +38,11 @@ public:
     ~Road2();
 
     void addBlock(Ogre::Vector3 pos, Ogre::Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype = 1);
-    /**
-     * @param p1 Top left point.
-     * @param p2 Top right point.
-     */
-    void addQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
-    void addCollisionQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, ground_model_t* gm, bool flip = false);
-    void createMesh();
+    /// Call after all blocks were added; returns the number of segments for `generateSegment()`.
+    int  prepareSegments();
+    /// Builds geometry of one segment; thread-safe, so segments of many roads can be generated in one batch.
+    void generateSegment(int index);
+    /// Registers collision and creates the mesh from generated segments; call once, on main thread.
     void finish();
     void setCollisionEnabled(bool v) { collision = v; }
 
@@ -76,6 +77,45 @@ public:
 
 private:
 
+    /// Block as given to `addBlock()`, with automatic type resolved
+    struct Block
+    {
+        Ogre::Vector3    pos;
+        Ogre::Quaternion rot;
+        int              type;
+        float            width;
+        float            bwidth;
+        float            bheight;
+        int              pillartype;
+    };
+
+    struct CollisionQuad
+    {
+        Ogre::Vector3   p1, p2, p3, p4;
+        ground_model_t* gm;
+        bool            flip;
+    };
+
+    /// Geometry joining 2 consecutive blocks; the first and last segment are the end caps.
+    /// Generated on worker threads, so it only holds plain arrays - the collision is registered on main thread.
+    struct Segment
+    {
+        std::vector<Ogre::Vector3> vertices;  //!< 4 per quad
+        std::vector<Ogre::Vector3> normals;
+        std::vector<Ogre::Vector2> texcoords;
+        std::vector<uint16_t>      indices;   //!< 6 per quad, relative to the segment's first vertex
+        std::vector<CollisionQuad> coll_quads;
+        int                        num_quads_used = 0; //!< Quads which fit into the mesh
+        Ogre::Vector3              pts[8];    //!< Block profile points, for diagnostics
+    };
+
+    void resolveBlock(Block& b, bool first);
+    void generatePillar(Segment& seg, Ogre::Vector3* pts, Ogre::Vector3* lpts, Block const& cur, Block const& last, int pillar_index);
+    void registerCollision(Segment& seg);
+    void createMesh();
+    void logBlock(Block const& b, Segment const& seg);
+
+    void addQuad(Segment& seg, Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
     inline Ogre::Vector3 baseOf(Ogre::Vector3 p);
     void computePoints(Ogre::Vector3* pts, Ogre::Vector3 pos, Ogre::Quaternion rot, int type, float width, float bwidth, float bheight);
     void textureFit(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, Ogre::Vector2* texc, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width);
@@ -89,25 +129,17 @@ private:
 
     Ogre::MeshPtr msh;
     Ogre::SubMesh* mainsub;
-
-    Ogre::Vector2 tex[MAX_VERTEX];
-    Ogre::Vector3 vertex[MAX_VERTEX];
-    int tricount;
-    int vertexcount;
-    short tris[MAX_TRIS * 3];
-
-    Ogre::Quaternion lastrot;
     Ogre::SceneNode* snode;
-    Ogre::Vector3 lastpos;
-    bool first;
-    float lastbheight;
-    float lastbwidth;
-    float lastwidth;
-    int lasttype;
+
+    std::vector<Block>   m_blocks;
+    std::vector<int>     m_pillar_indices;  //!< Per block; drives the monorail "every fifth pillar" rule
+    int                  m_pillar_counter;
+    std::vector<Segment> m_segments;        //!< `m_blocks.size() + 1` entries
+    ground_model_t*      m_gm_concrete;
+    ground_model_t*      m_gm_asphalt;
     int mid;
     bool collision; //!< Register collision triangles?
     std::vector<int> registeredCollTris;
 };
 
 } // namespace RoR
-
@@ -49,6 +49,9 @@
 #include "Utils.h"
 
 #include <Ogre.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 
 RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_resource_group,
                         std::vector<NodeGfx>& gfx_nodes, RoR::Renderdash* renderdash):
@@ -77,6 +80,7 @@ RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_re
     m_particles_clump  = App::GetGfxScene()->GetDustPool("clump");
 
     m_simbuf.simbuf_nodes.reset(new SimBuffer::NodeSB[actor->ar_num_nodes]);
+    m_simbuf_nodes_back.reset(new SimBuffer::NodeSB[actor->ar_num_nodes]);
     m_simbuf.simbuf_aeroengines.resize(actor->ar_num_aeroengines);
     m_simbuf.simbuf_commandkey.resize(MAX_COMMANDS + 10);
     m_simbuf.simbuf_airbrakes.resize(spawner->GetMemoryRequirements().num_airbrakes);
@@ -99,10 +103,26 @@ RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_re
         m_attr.xa_num_gears = actor->ar_engine->getNumGears();
         m_attr.xa_engine_max_rpm = actor->ar_engine->getMaxRPM();
     }
+
+    // Flares
+    m_flare_material_on.resize(actor->ar_flares.size(), -1);
+    for (flare_t& flare: actor->ar_flares)
+    {
+        if (flare.bbs != nullptr &&
+            std::find(m_flare_billboard_sets.begin(), m_flare_billboard_sets.end(), flare.bbs) == m_flare_billboard_sets.end())
+        {
+            m_flare_billboard_sets.push_back(flare.bbs);
+        }
+    }
 }
 
 RoR::GfxActor::~GfxActor()
 {
+    if (m_prop_anim_task)
+    {
+        m_prop_anim_task->join();
+    }
+
     // Dispose videocameras
     this->SetVideoCamState(VideoCamState::VCSTATE_DISABLED);
     while (!m_videocameras.empty())
@@ -119,12 +139,7 @@ RoR::GfxActor::~GfxActor()
     // Dispose rods
     if (m_rods_parent_scenenode != nullptr)
     {
-        for (Rod& rod: m_rods)
-        {
-            Ogre::MovableObject* ogre_object = rod.rod_scenenode->getAttachedObject(0);
-            rod.rod_scenenode->detachAllObjects();
-            App::GetGfxScene()->GetSceneManager()->destroyEntity(static_cast<Ogre::Entity*>(ogre_object));
-        }
+        this->DisposeRodBatches();
         m_rods.clear();
 
         m_rods_parent_scenenode->removeAndDestroyAllChildren();
@@ -1559,62 +1574,315 @@ void RoR::GfxActor::CycleDebugViews()
     }
 }
 
-void RoR::GfxActor::AddRod(int beam_index,  int node1_index, int node2_index, const char* material_name, bool visible, float diameter_meters)
+/// Geometry of 'beam.mesh' (unit diameter and length, centered, along Y axis), shared by all `RodBatch`-es.
+struct RodMeshTemplate
+{
+    std::vector<Ogre::Vector3> rmt_positions;
+    std::vector<Ogre::Vector3> rmt_normals;
+    std::vector<Ogre::Vector2> rmt_texcoords;
+    std::vector<uint32_t>      rmt_indices;
+};
+
+static void ReadRodMeshElement(Ogre::VertexData* vertex_data, Ogre::VertexElementSemantic semantic, size_t num_floats, float* out)
 {
-    try
+    const Ogre::VertexElement* elem = vertex_data->vertexDeclaration->findElementBySemantic(semantic);
+    if (elem == nullptr ||
+        Ogre::VertexElement::getBaseType(elem->getType()) != Ogre::VET_FLOAT1 ||
+        Ogre::VertexElement::getTypeCount(elem->getType()) < num_floats)
     {
-        Str<100> entity_name;
-        entity_name << "rod" << beam_index << "@actor" << m_actor->ar_instance_id;
-        Ogre::Entity* entity = App::GetGfxScene()->GetSceneManager()->createEntity(entity_name.ToCStr(), "beam.mesh");
-        entity->setMaterialName(material_name);
+        return; // Leave zeros
+    }
 
-        if (m_rods_parent_scenenode == nullptr)
+    Ogre::HardwareVertexBufferSharedPtr vbuf = vertex_data->vertexBufferBinding->getBuffer(elem->getSource());
+    unsigned char* vertex = static_cast<unsigned char*>(vbuf->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+    vertex += vertex_data->vertexStart * vbuf->getVertexSize();
+    for (size_t i = 0; i < vertex_data->vertexCount; ++i, vertex += vbuf->getVertexSize())
+    {
+        float* src = nullptr;
+        elem->baseVertexPointerToElement(vertex, &src);
+        for (size_t j = 0; j < num_floats; ++j)
         {
-            m_rods_parent_scenenode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
+            *out++ = src[j];
         }
+    }
+    vbuf->unlock();
+}
 
-        Rod rod;
-        rod.rod_scenenode = m_rods_parent_scenenode->createChildSceneNode();
-        rod.rod_scenenode->attachObject(entity);
-        rod.rod_scenenode->setVisible(visible, /*cascade=*/ false);
+static const RodMeshTemplate& GetRodMeshTemplate()
+{
+    static RodMeshTemplate s_template;
+    if (!s_template.rmt_indices.empty())
+    {
+        return s_template;
+    }
 
-        rod.rod_scenenode->setScale(diameter_meters, -1, diameter_meters);
-        rod.rod_diameter_mm = uint16_t(diameter_meters * 1000.f);
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().load(
+        "beam.mesh", Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
 
-        rod.rod_beam_index = static_cast<uint16_t>(beam_index);
-        rod.rod_node1 = static_cast<uint16_t>(node1_index);
-        rod.rod_node2 = static_cast<uint16_t>(node2_index);
-        rod.rod_target_actor = m_actor;
-        rod.rod_is_visible = false;
+    RodMeshTemplate tpl;
+    size_t shared_offset = SIZE_MAX;
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+    {
+        Ogre::SubMesh* submesh = mesh->getSubMesh(i);
+        Ogre::VertexData* vertex_data = (submesh->useSharedVertices) ? mesh->sharedVertexData : submesh->vertexData;
 
-        m_rods.push_back(rod);
+        size_t offset = tpl.rmt_positions.size();
+        if (submesh->useSharedVertices && shared_offset != SIZE_MAX)
+        {
+            offset = shared_offset;
+        }
+        else if (vertex_data->vertexCount > 0)
+        {
+            if (submesh->useSharedVertices)
+            {
+                shared_offset = offset;
+            }
+            tpl.rmt_positions.resize(offset + vertex_data->vertexCount, Ogre::Vector3::ZERO);
+            tpl.rmt_normals.resize(offset + vertex_data->vertexCount, Ogre::Vector3::ZERO);
+            tpl.rmt_texcoords.resize(offset + vertex_data->vertexCount, Ogre::Vector2::ZERO);
+            ReadRodMeshElement(vertex_data, Ogre::VES_POSITION, 3, tpl.rmt_positions[offset].ptr());
+            ReadRodMeshElement(vertex_data, Ogre::VES_NORMAL, 3, tpl.rmt_normals[offset].ptr());
+            ReadRodMeshElement(vertex_data, Ogre::VES_TEXTURE_COORDINATES, 2, tpl.rmt_texcoords[offset].ptr());
+        }
+
+        Ogre::IndexData* index_data = submesh->indexData;
+        Ogre::HardwareIndexBufferSharedPtr ibuf = index_data->indexBuffer;
+        const bool use_32bit = (ibuf->getType() == Ogre::HardwareIndexBuffer::IT_32BIT);
+        const void* src = ibuf->lock(Ogre::HardwareBuffer::HBL_READ_ONLY);
+        for (size_t j = index_data->indexStart; j < index_data->indexStart + index_data->indexCount; ++j)
+        {
+            const uint32_t index = (use_32bit) ? static_cast<const uint32_t*>(src)[j] : static_cast<const uint16_t*>(src)[j];
+            tpl.rmt_indices.push_back(static_cast<uint32_t>(offset) + index);
+        }
+        ibuf->unlock();
     }
-    catch (Ogre::Exception& e)
+
+    if (tpl.rmt_indices.empty())
     {
-        LogFormat("[RoR|Gfx] Failed to create visuals for beam %d, message: %s", beam_index, e.getFullDescription().c_str());
+        OGRE_EXCEPT(Ogre::Exception::ERR_INVALIDPARAMS, "'beam.mesh' has no geometry", "GetRodMeshTemplate");
     }
+
+    s_template = tpl;
+    return s_template;
+}
+
+void RoR::GfxActor::AddRod(int beam_index,  int node1_index, int node2_index, const char* material_name, bool visible, float diameter_meters)
+{
+    if (m_rods_parent_scenenode == nullptr)
+    {
+        m_rods_parent_scenenode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
+    }
+
+    // Rods are drawn in batches by material, see `UpdateRods()`
+    auto batch_itor = std::find_if(m_rod_batches.begin(), m_rod_batches.end(),
+        [material_name](RodBatch const& batch) { return batch.rb_material_name == material_name; });
+    if (batch_itor == m_rod_batches.end())
+    {
+        RodBatch batch;
+        batch.rb_material_name = material_name;
+        m_rod_batches.push_back(batch);
+        batch_itor = m_rod_batches.end() - 1;
+    }
+
+    Rod rod;
+    rod.rod_diameter_mm = uint16_t(diameter_meters * 1000.f);
+    rod.rod_beam_index = static_cast<uint16_t>(beam_index);
+    rod.rod_node1 = static_cast<uint16_t>(node1_index);
+    rod.rod_node2 = static_cast<uint16_t>(node2_index);
+    rod.rod_target_actor = m_actor;
+    rod.rod_is_visible = visible;
+
+    batch_itor->rb_rods.push_back(static_cast<uint16_t>(m_rods.size()));
+    m_rods.push_back(rod);
+}
+
+void RoR::GfxActor::SetupRodBatchMesh(RodBatch& batch)
+{
+    const RodMeshTemplate& tpl = GetRodMeshTemplate();
+    const size_t vertex_count = batch.rb_rods.size() * tpl.rmt_positions.size();
+    const size_t index_count = batch.rb_rods.size() * tpl.rmt_indices.size();
+
+    if (batch.rb_mesh.isNull())
+    {
+        Str<100> mesh_name;
+        mesh_name << "rods" << (&batch - &m_rod_batches[0]) << "@actor" << m_actor->ar_instance_id;
+        batch.rb_mesh = Ogre::MeshManager::getSingleton().createManual(mesh_name.ToCStr(), m_custom_resource_group);
+
+        Ogre::SubMesh* submesh = batch.rb_mesh->createSubMesh();
+        submesh->setMaterialName(batch.rb_material_name);
+        submesh->useSharedVertices = false;
+        submesh->vertexData = new Ogre::VertexData();
+
+        // Same layout as FlexObj
+        Ogre::VertexDeclaration* decl = submesh->vertexData->vertexDeclaration;
+        size_t offset = 0;
+        decl->addElement(0, offset, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+        offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+        decl->addElement(0, offset, Ogre::VET_FLOAT3, Ogre::VES_NORMAL);
+        offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+        decl->addElement(0, offset, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, 0);
+    }
+
+    // (Re)create buffers for the current number of rods
+    Ogre::SubMesh* submesh = batch.rb_mesh->getSubMesh(0);
+    batch.rb_vertex_buf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        submesh->vertexData->vertexDeclaration->getVertexSize(0), vertex_count,
+        Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    submesh->vertexData->vertexBufferBinding->setBinding(0, batch.rb_vertex_buf);
+    submesh->vertexData->vertexStart = 0;
+    submesh->vertexData->vertexCount = 0;
+
+    // Index buffer is static - the same template indices, offset for each rod slot
+    const bool use_32bit = (vertex_count > std::numeric_limits<uint16_t>::max());
+    Ogre::HardwareIndexBufferSharedPtr ibuf = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        (use_32bit) ? Ogre::HardwareIndexBuffer::IT_32BIT : Ogre::HardwareIndexBuffer::IT_16BIT,
+        index_count, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    void* dst = ibuf->lock(Ogre::HardwareBuffer::HBL_DISCARD);
+    size_t pos = 0;
+    for (size_t i = 0; i < batch.rb_rods.size(); ++i)
+    {
+        const uint32_t base = static_cast<uint32_t>(i * tpl.rmt_positions.size());
+        for (uint32_t index: tpl.rmt_indices)
+        {
+            if (use_32bit)
+                static_cast<uint32_t*>(dst)[pos++] = base + index;
+            else
+                static_cast<uint16_t*>(dst)[pos++] = static_cast<uint16_t>(base + index);
+        }
+    }
+    ibuf->unlock();
+    submesh->indexData->indexBuffer = ibuf;
+    submesh->indexData->indexStart = 0;
+    submesh->indexData->indexCount = 0;
+
+    if (batch.rb_entity == nullptr)
+    {
+        batch.rb_mesh->_setBounds(Ogre::AxisAlignedBox(-1, -1, -1, 1, 1, 1), true);
+        batch.rb_mesh->load();
+
+        batch.rb_entity = App::GetGfxScene()->GetSceneManager()->createEntity(batch.rb_mesh);
+        m_rods_parent_scenenode->attachObject(batch.rb_entity);
+    }
+
+    batch.rb_instances.reserve(batch.rb_rods.size());
+    batch.rb_capacity = batch.rb_rods.size();
+}
+
+void RoR::GfxActor::DisposeRodBatches()
+{
+    for (RodBatch& batch: m_rod_batches)
+    {
+        if (batch.rb_entity != nullptr)
+        {
+            batch.rb_entity->detachFromParent();
+            App::GetGfxScene()->GetSceneManager()->destroyEntity(batch.rb_entity);
+            batch.rb_entity = nullptr;
+        }
+        if (!batch.rb_mesh.isNull())
+        {
+            Ogre::MeshManager::getSingleton().remove(batch.rb_mesh->getHandle());
+            batch.rb_mesh.setNull();
+        }
+    }
+    m_rod_batches.clear();
 }
 
 void RoR::GfxActor::UpdateRods()
 {
-    for (Rod& rod: m_rods)
+    SimBuffer::NodeSB* nodes1 = this->GetSimNodeBuffer();
+    bool bounds_changed = false;
+    for (RodBatch& batch: m_rod_batches)
     {
-        rod.rod_scenenode->setVisible(rod.rod_is_visible);
-        if (!rod.rod_is_visible)
+        if (batch.rb_capacity != batch.rb_rods.size())
+        {
+            try
+            {
+                this->SetupRodBatchMesh(batch);
+            }
+            catch (Ogre::Exception& e)
+            {
+                LogFormat("[RoR|Gfx] Failed to create visuals for beams (material: %s), message: %s",
+                    batch.rb_material_name.c_str(), e.getFullDescription().c_str());
+                batch.rb_rods.clear(); // Don't retry
+                batch.rb_capacity = 0;
+            }
+        }
+        if (batch.rb_entity == nullptr)
+            continue;
+
+        // Compute transforms of all visible rods
+        batch.rb_instances.clear();
+        Ogre::AxisAlignedBox bounds;
+        float max_diameter = 0.f;
+        for (uint16_t rod_index: batch.rb_rods)
+        {
+            const Rod& rod = m_rods[rod_index];
+            if (!rod.rod_is_visible)
+                continue;
+
+            SimBuffer::NodeSB* nodes2 = rod.rod_target_actor->GetGfxActor()->GetSimNodeBuffer();
+            const Ogre::Vector3 pos1 = nodes1[rod.rod_node1].AbsPosition;
+            const Ogre::Vector3 pos2 = nodes2[rod.rod_node2].AbsPosition;
+
+            RodInstance inst;
+            inst.ri_center = pos1.midPoint(pos2);
+            inst.ri_diameter = static_cast<float>(rod.rod_diameter_mm) * 0.001f;
+            inst.ri_length = pos1.distance(pos2);
+            GfxActor::SpecialGetRotationTo(Ogre::Vector3::UNIT_Y, (pos1 - pos2)).ToAxes(inst.ri_axis_x, inst.ri_axis_y, inst.ri_axis_z);
+            batch.rb_instances.push_back(inst);
+
+            bounds.merge(pos1);
+            bounds.merge(pos2);
+            max_diameter = std::max(max_diameter, inst.ri_diameter);
+        }
+
+        batch.rb_entity->setVisible(!batch.rb_instances.empty());
+        if (batch.rb_instances.empty())
             continue;
 
-        SimBuffer::NodeSB* nodes1 = this->GetSimNodeBuffer();
-        Ogre::Vector3 pos1 = nodes1[rod.rod_node1].AbsPosition;
-        SimBuffer::NodeSB* nodes2 = rod.rod_target_actor->GetGfxActor()->GetSimNodeBuffer();
-        Ogre::Vector3 pos2 = nodes2[rod.rod_node2].AbsPosition;
+        // Stamp the template geometry for each rod
+        const RodMeshTemplate& tpl = GetRodMeshTemplate();
+        const size_t tpl_vertex_count = tpl.rmt_positions.size();
+        const size_t vertex_count = batch.rb_instances.size() * tpl_vertex_count;
+        float* dst = static_cast<float*>(batch.rb_vertex_buf->lock(
+            0, vertex_count * batch.rb_vertex_buf->getVertexSize(), Ogre::HardwareBuffer::HBL_DISCARD));
+        for (const RodInstance& inst: batch.rb_instances)
+        {
+            for (size_t i = 0; i < tpl_vertex_count; ++i)
+            {
+                const Ogre::Vector3& p = tpl.rmt_positions[i];
+                const Ogre::Vector3& n = tpl.rmt_normals[i];
+                const Ogre::Vector3 pos = inst.ri_center
+                    + inst.ri_axis_x * (p.x * inst.ri_diameter)
+                    + inst.ri_axis_y * (p.y * inst.ri_length)
+                    + inst.ri_axis_z * (p.z * inst.ri_diameter);
+                const Ogre::Vector3 normal = inst.ri_axis_x * n.x + inst.ri_axis_y * n.y + inst.ri_axis_z * n.z;
+                *dst++ = pos.x;
+                *dst++ = pos.y;
+                *dst++ = pos.z;
+                *dst++ = normal.x;
+                *dst++ = normal.y;
+                *dst++ = normal.z;
+                *dst++ = tpl.rmt_texcoords[i].x;
+                *dst++ = tpl.rmt_texcoords[i].y;
+            }
+        }
+        batch.rb_vertex_buf->unlock();
 
-        // Classic method
-        float beam_diameter = static_cast<float>(rod.rod_diameter_mm) * 0.001;
-        float beam_length = pos1.distance(pos2);
+        Ogre::SubMesh* submesh = batch.rb_mesh->getSubMesh(0);
+        submesh->vertexData->vertexCount = vertex_count;
+        submesh->indexData->indexCount = batch.rb_instances.size() * tpl.rmt_indices.size();
 
-        rod.rod_scenenode->setPosition(pos1.midPoint(pos2));
-        rod.rod_scenenode->setScale(beam_diameter, beam_length, beam_diameter);
-        rod.rod_scenenode->setOrientation(GfxActor::SpecialGetRotationTo(Ogre::Vector3::UNIT_Y, (pos1 - pos2)));
+        const Ogre::Vector3 pad(max_diameter * 0.5f);
+        bounds.setExtents(bounds.getMinimum() - pad, bounds.getMaximum() + pad);
+        batch.rb_mesh->_setBounds(bounds, false);
+        batch.rb_mesh->_setBoundingSphereRadius(bounds.getHalfSize().length());
+        bounds_changed = true;
+    }
+
+    if (bounds_changed)
+    {
+        m_rods_parent_scenenode->needUpdate(); // Refresh world bounds used for culling
     }
 }
 
@@ -1724,6 +1992,19 @@ void RoR::GfxActor::SetRodsVisible(bool visible)
     }
 }
 
+void RoR::GfxActor::UpdateSimNodeBackBuffer()
+{
+    SimBuffer::NodeSB* back_nodes = m_simbuf_nodes_back.get();
+    const int num_nodes = m_actor->ar_num_nodes;
+    for (int i = 0; i < num_nodes; ++i)
+    {
+        const node_t& node = m_actor->ar_nodes[i];
+        back_nodes[i].AbsPosition = node.AbsPosition;
+        back_nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+    }
+    m_simbuf_nodes_back_ready = true;
+}
+
 void RoR::GfxActor::UpdateSimDataBuffer()
 {
     m_simbuf.simbuf_live_local = (m_actor->ar_sim_state == Actor::SimState::LOCAL_SIMULATED);
@@ -1751,13 +2032,21 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     m_simbuf.simbuf_net_username = m_actor->m_net_username;
     m_simbuf.simbuf_is_remote = m_actor->ar_sim_state == Actor::SimState::NETWORKED_OK;
 
-    // nodes
-    const int num_nodes = m_actor->ar_num_nodes;
-    for (int i = 0; i < num_nodes; ++i)
+    // nodes - take the snapshot written by the simulation thread if it's still up to date
+    if (m_simbuf_nodes_back_ready)
     {
-        auto node = m_actor->ar_nodes[i];
-        m_simbuf.simbuf_nodes.get()[i].AbsPosition = node.AbsPosition;
-        m_simbuf.simbuf_nodes.get()[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        std::swap(m_simbuf.simbuf_nodes, m_simbuf_nodes_back);
+        m_simbuf_nodes_back_ready = false;
+    }
+    else
+    {
+        const int num_nodes = m_actor->ar_num_nodes;
+        for (int i = 0; i < num_nodes; ++i)
+        {
+            const node_t& node = m_actor->ar_nodes[i];
+            m_simbuf.simbuf_nodes.get()[i].AbsPosition = node.AbsPosition;
+            m_simbuf.simbuf_nodes.get()[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        }
     }
 
     for (NodeGfx& nx: m_gfx_nodes)
@@ -1895,9 +2184,14 @@ void RoR::GfxActor::SetWheelVisuals(uint16_t index, WheelGfx wheel_gfx)
     m_wheels[index] = wheel_gfx;
 }
 
-void RoR::GfxActor::UpdateWheelVisuals()
+void RoR::GfxActor::UpdateWheelVisuals(bool deform)
 {
     m_flexwheel_tasks.clear();
+    m_flexwheels_deformed = deform;
+    if (!deform)
+    {
+        return;
+    }
 
     for (WheelGfx& w: m_wheels)
     {
@@ -1919,6 +2213,10 @@ void RoR::GfxActor::FinishWheelUpdates()
     {
         task->join();
     }
+    if (!m_flexwheels_deformed)
+    {
+        return;
+    }
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_scenenode != nullptr && w.wx_flex_mesh != nullptr)
@@ -1991,6 +2289,45 @@ void RoR::GfxActor::RegisterProps(std::vector<Prop> const& props, int driverseat
 {
     m_props = props;
     m_driverseat_prop_index = driverseat_prop_idx;
+    m_prop_transforms.resize(m_props.size());
+
+    // Group animations by input, see `CalcPropAnimations()`
+    const int CALC_FLAGS = ~(PROP_ANIM_FLAG_STEERING | PROP_ANIM_FLAG_EVENT | PROP_ANIM_FLAG_AILERONS |
+        PROP_ANIM_FLAG_ARUDDER | PROP_ANIM_FLAG_PERMANENT | PROP_ANIM_FLAG_ELEVATORS); // Handled by `CalcPropAnimation()`
+    const int STATEFUL_FLAGS = PROP_ANIM_FLAG_TORQUE | PROP_ANIM_FLAG_SHIFTER;
+    for (Prop& prop: m_props)
+    {
+        for (PropAnim& anim: prop.pp_animations)
+        {
+            const int calc_flags = anim.animFlags & CALC_FLAGS;
+            if (calc_flags == 0)
+            {
+                anim.animSourceIdx = PropAnim::SOURCE_NONE;
+            }
+            else if (calc_flags & STATEFUL_FLAGS)
+            {
+                anim.animSourceIdx = PropAnim::SOURCE_STATEFUL;
+            }
+            else
+            {
+                auto itor = std::find_if(m_prop_anim_sources.begin(), m_prop_anim_sources.end(),
+                    [calc_flags, &anim](PropAnimSource const& src) { return src.pas_flags == calc_flags && src.pas_option3 == anim.animOpt3; });
+                anim.animSourceIdx = static_cast<int>(itor - m_prop_anim_sources.begin());
+                if (itor == m_prop_anim_sources.end())
+                {
+                    PropAnimSource src;
+                    src.pas_flags = calc_flags;
+                    src.pas_option3 = anim.animOpt3;
+                    m_prop_anim_sources.push_back(src);
+                }
+            }
+
+            if ((anim.animFlags & PROP_ANIM_FLAG_EVENT) && anim.animKey != -1)
+            {
+                m_prop_anim_keyed.push_back(&anim);
+            }
+        }
+    }
 }
 
 void RoR::GfxActor::UpdateAirbrakes()
@@ -2088,6 +2425,10 @@ void RoR::GfxActor::UpdateNetLabels(float dt)
 void RoR::GfxActor::CalculateDriverPos(Ogre::Vector3& out_pos, Ogre::Quaternion& out_rot)
 {
     ROR_ASSERT(m_driverseat_prop_index != -1);
+    if (m_prop_anim_task)
+    {
+        m_prop_anim_task->join(); // The seat prop may be animated
+    }
     Prop* driverseat_prop = &m_props[m_driverseat_prop_index];
 
     SimBuffer::NodeSB* nodes = this->GetSimNodeBuffer();
@@ -2122,6 +2463,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
     using namespace Ogre;
 
     bool enableAll = !((App::gfx_flares_mode->GetEnum<GfxFlaresMode>() == GfxFlaresMode::CURR_VEHICLE_HEAD_ONLY) && !is_player_actor);
+    const bool enableLight = enableAll && (App::gfx_flares_mode->GetEnum<GfxFlaresMode>() != GfxFlaresMode::NO_LIGHTSOURCES);
     SimBuffer::NodeSB* nodes = this->GetSimNodeBuffer();
 
     if (prop.pp_beacon_type == 'b')
@@ -2143,6 +2485,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
         if (vlen > 100.0)
         {
             prop.pp_beacon_scene_node[0]->setVisible(false);
+            this->SetFlareLightVisible(pp_beacon_light, false, vlen);
             return;
         }
         //normalize
@@ -2158,7 +2501,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
         {
             prop.pp_beacon_scene_node[0]->setVisible(false);
         }
-        pp_beacon_light->setVisible(enableAll);
+        this->SetFlareLightVisible(pp_beacon_light, enableLight, vlen);
 
         // Update
         prop.pp_beacon_rot_angle[0] = beacon_rotation_angle;
@@ -2189,6 +2532,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
             if (vlen > 100.0)
             {
                 prop.pp_beacon_scene_node[k]->setVisible(false);
+                this->SetFlareLightVisible(prop.pp_beacon_light[k], false, vlen);
                 continue;
             }
             //normalize
@@ -2204,7 +2548,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
             {
                 prop.pp_beacon_scene_node[k]->setVisible(false);
             }
-            prop.pp_beacon_light[k]->setVisible(enableAll);
+            this->SetFlareLightVisible(prop.pp_beacon_light[k], enableLight, vlen);
         }
     }
     else if (prop.pp_beacon_type == 'r')
@@ -2219,6 +2563,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
         if (vlen > 100.0)
         {
             prop.pp_beacon_scene_node[0]->setVisible(false);
+            this->SetFlareLightVisible(prop.pp_beacon_light[0], false, vlen);
             return;
         }
         //normalize
@@ -2231,7 +2576,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
             visible = true;
         }
         visible = visible && enableAll;
-        prop.pp_beacon_light[0]->setVisible(visible);
+        this->SetFlareLightVisible(prop.pp_beacon_light[0], visible && enableLight, vlen);
         prop.pp_beacon_scene_node[0]->setVisible(visible);
     }
     else if (prop.pp_beacon_type == 'R' || prop.pp_beacon_type == 'L') // Avionic navigation lights (red/green)
@@ -2260,6 +2605,7 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
         if (vlen > 100.0)
         {
             prop.pp_beacon_scene_node[0]->setVisible(false);
+            this->SetFlareLightVisible(prop.pp_beacon_light[0], false, vlen);
             return;
         }
         //normalize
@@ -2272,20 +2618,66 @@ void RoR::GfxActor::UpdateBeaconFlare(Prop & prop, float dt, bool is_player_acto
             visible = true;
         }
         visible = visible && enableAll;
-        prop.pp_beacon_light[0]->setVisible(visible);
+        this->SetFlareLightVisible(prop.pp_beacon_light[0], visible && enableLight, vlen);
         prop.pp_beacon_scene_node[0]->setVisible(visible);
     }
 }
 
-void RoR::GfxActor::UpdateProps(float dt, bool is_player_actor)
+void RoR::GfxActor::CalcPropTransforms()
 {
     using namespace Ogre;
 
     SimBuffer::NodeSB* nodes = this->GetSimNodeBuffer();
 
+    for (size_t i = 0; i < m_props.size(); ++i)
+    {
+        const Prop& prop = m_props[i];
+        PropTransform& xform = m_prop_transforms[i];
+        if (prop.pp_scene_node == nullptr) // Wing beacons don't have scenenodes
+            continue;
+
+        // -- quick ugly port from `Actor::updateProps()` --- ~ 06/2018
+        Vector3 diffX = nodes[prop.pp_node_x].AbsPosition - nodes[prop.pp_node_ref].AbsPosition;
+        Vector3 diffY = nodes[prop.pp_node_y].AbsPosition - nodes[prop.pp_node_ref].AbsPosition;
+
+        Vector3 normal = (diffY.crossProduct(diffX)).normalisedCopy();
+
+        Vector3 mposition = nodes[prop.pp_node_ref].AbsPosition + prop.pp_offset.x * diffX + prop.pp_offset.y * diffY;
+        xform.pt_position = mposition + normal * prop.pp_offset.z;
+
+        Vector3 refx = diffX.normalisedCopy();
+        Vector3 refy = refx.crossProduct(normal);
+        xform.pt_orientation = Quaternion(refx, normal, refy) * prop.pp_rot;
+
+        if (prop.pp_wheel_scene_node) // special prop - steering wheel
+        {
+            Quaternion brot = Quaternion(Degree(-59.0), Vector3::UNIT_X);
+            brot = brot * Quaternion(Degree(m_simbuf.simbuf_hydro_dir_state * prop.pp_wheel_rot_degree), Vector3::UNIT_Y);
+            xform.pt_wheel_position = xform.pt_position + xform.pt_orientation * prop.pp_wheel_pos;
+            xform.pt_wheel_orientation = xform.pt_orientation * brot;
+        }
+    }
+}
+
+void RoR::GfxActor::UpdateProps(float dt, bool is_player_actor)
+{
+    using namespace Ogre;
+
+    // Live actors have the transforms calculated along with animations, see `UpdatePropAnimations()`
+    if (m_prop_anim_task)
+    {
+        m_prop_anim_task->join();
+        m_prop_anim_task = nullptr;
+    }
+    else
+    {
+        this->CalcPropTransforms();
+    }
+
     // Update prop meshes
-    for (Prop& prop: m_props)
+    for (size_t i = 0; i < m_props.size(); ++i)
     {
+        Prop& prop = m_props[i];
         if (prop.pp_scene_node == nullptr) // Wing beacons don't have scenenodes
             continue;
 
@@ -2310,26 +2702,14 @@ void RoR::GfxActor::UpdateProps(float dt, bool is_player_actor)
         }
 
         // Update position and orientation
-        // -- quick ugly port from `Actor::updateProps()` --- ~ 06/2018
-        Vector3 diffX = nodes[prop.pp_node_x].AbsPosition - nodes[prop.pp_node_ref].AbsPosition;
-        Vector3 diffY = nodes[prop.pp_node_y].AbsPosition - nodes[prop.pp_node_ref].AbsPosition;
-
-        Vector3 normal = (diffY.crossProduct(diffX)).normalisedCopy();
-
-        Vector3 mposition = nodes[prop.pp_node_ref].AbsPosition + prop.pp_offset.x * diffX + prop.pp_offset.y * diffY;
-        prop.pp_scene_node->setPosition(mposition + normal * prop.pp_offset.z);
-
-        Vector3 refx = diffX.normalisedCopy();
-        Vector3 refy = refx.crossProduct(normal);
-        Quaternion orientation = Quaternion(refx, normal, refy) * prop.pp_rot;
-        prop.pp_scene_node->setOrientation(orientation);
+        const PropTransform& xform = m_prop_transforms[i];
+        prop.pp_scene_node->setPosition(xform.pt_position);
+        prop.pp_scene_node->setOrientation(xform.pt_orientation);
 
         if (prop.pp_wheel_scene_node) // special prop - steering wheel
         {
-            Quaternion brot = Quaternion(Degree(-59.0), Vector3::UNIT_X);
-            brot = brot * Quaternion(Degree(m_simbuf.simbuf_hydro_dir_state * prop.pp_wheel_rot_degree), Vector3::UNIT_Y);
-            prop.pp_wheel_scene_node->setPosition(mposition + normal * prop.pp_offset.z + orientation * prop.pp_wheel_pos);
-            prop.pp_wheel_scene_node->setOrientation(orientation * brot);
+            prop.pp_wheel_scene_node->setPosition(xform.pt_wheel_position);
+            prop.pp_wheel_scene_node->setOrientation(xform.pt_wheel_orientation);
         }
     }
 
@@ -2390,14 +2770,13 @@ void RoR::GfxActor::UpdateRenderdashRTT()
 
 void RoR::GfxActor::SetBeaconsEnabled(bool beacon_light_is_active)
 {
-    const bool enableLight = (App::gfx_flares_mode->GetEnum<GfxFlaresMode>() != GfxFlaresMode::NO_LIGHTSOURCES);
-
+    // Beacon lights are only hidden here; `UpdateBeaconFlare()` requests them per frame, subject to `GfxScene::UpdateFlareLights()`
     for (Prop& prop: m_props)
     {
         char beacon_type = prop.pp_beacon_type;
         if (beacon_type == 'b')
         {
-            prop.pp_beacon_light[0]->setVisible(beacon_light_is_active && enableLight);
+            this->SetFlareLightVisible(prop.pp_beacon_light[0], false, 0.f);
             prop.pp_beacon_scene_node[0]->setVisible(beacon_light_is_active);
             if (prop.pp_beacon_bbs[0] && beacon_light_is_active && !prop.pp_beacon_scene_node[0]->numAttachedObjects())
             {
@@ -2422,7 +2801,7 @@ void RoR::GfxActor::SetBeaconsEnabled(bool beacon_light_is_active)
         {
             for (int k = 0; k < 4; k++)
             {
-                prop.pp_beacon_light[k]->setVisible(beacon_light_is_active && enableLight);
+                this->SetFlareLightVisible(prop.pp_beacon_light[k], false, 0.f);
                 prop.pp_beacon_scene_node[k]->setVisible(beacon_light_is_active);
                 if (prop.pp_beacon_bbs[k] && beacon_light_is_active && !prop.pp_beacon_scene_node[k]->numAttachedObjects())
                     prop.pp_beacon_scene_node[k]->attachObject(prop.pp_beacon_bbs[k]);
@@ -2436,7 +2815,7 @@ void RoR::GfxActor::SetBeaconsEnabled(bool beacon_light_is_active)
             {
                 if (prop.pp_beacon_light[k])
                 {
-                    prop.pp_beacon_light[k]->setVisible(beacon_light_is_active && enableLight);
+                    this->SetFlareLightVisible(prop.pp_beacon_light[k], false, 0.f);
                 }
                 if (prop.pp_beacon_scene_node[k])
                 {
@@ -2883,6 +3262,37 @@ void RoR::GfxActor::CalcPropAnimation(const int flag_state, float& cstate, int&
 
 void RoR::GfxActor::UpdatePropAnimations(float dt, bool is_player_connected)
 {
+    if (m_props.empty())
+        return;
+
+    if (is_player_connected)
+    {
+        for (PropAnim* anim: m_prop_anim_keyed)
+        {
+            // TODO: Keys shouldn't be queried from here, but buffered in sim. loop ~ only_a_ptr, 06/2018
+            anim->animKeyValue = RoR::App::GetInputEngine()->getEventValue(anim->animKey);
+        }
+    }
+
+    auto func = std::function<void()>([this, dt, is_player_connected]()
+        {
+            this->CalcPropAnimations(dt, is_player_connected);
+            this->CalcPropTransforms();
+        });
+    m_prop_anim_task = App::GetThreadPool()->RunTask(func);
+}
+
+void RoR::GfxActor::CalcPropAnimations(float dt, bool is_player_connected)
+{
+    // Evaluate each distinct input once
+    for (PropAnimSource& src: m_prop_anim_sources)
+    {
+        float cstate = 0.0f;
+        int div = 0;
+        this->CalcPropAnimation(src.pas_flags, cstate, div, dt, 0.f, 0.f, src.pas_option3);
+        src.pas_value = cstate;
+    }
+
     for (Prop& prop: m_props)
     {
         int animnum = 0;
@@ -2898,19 +3308,24 @@ void RoR::GfxActor::UpdatePropAnimations(float dt, bool is_player_connected)
             const float upper_limit = anim.upper_limit;
             float animOpt3 = anim.animOpt3;
 
-            this->CalcPropAnimation(anim.animFlags, cstate, div, dt, lower_limit, upper_limit, animOpt3);
+            if (anim.animSourceIdx >= 0)
+            {
+                cstate = m_prop_anim_sources[anim.animSourceIdx].pas_value;
+            }
+            else if (anim.animSourceIdx == PropAnim::SOURCE_STATEFUL)
+            {
+                this->CalcPropAnimation(anim.animFlags, cstate, div, dt, lower_limit, upper_limit, animOpt3);
+            }
 
             // key triggered animations
             if ((anim.animFlags & ANIM_FLAG_EVENT) && anim.animKey != -1 && is_player_connected)
             {
-                // TODO: Keys shouldn't be queried from here, but buffered in sim. loop ~ only_a_ptr, 06/2018
-                if (RoR::App::GetInputEngine()->getEventValue(anim.animKey))
+                if (anim.animKeyValue)
                 {
                     // keystatelock is disabled then set cstate
                     if (anim.animKeyState == -1.0f)
                     {
-                        // TODO: Keys shouldn't be queried from here, but buffered in sim. loop ~ only_a_ptr, 06/2018
-                        cstate += RoR::App::GetInputEngine()->getEventValue(anim.animKey);
+                        cstate += anim.animKeyValue;
                     }
                     else if (!anim.animKeyState)
                     {
@@ -3132,15 +3547,43 @@ void RoR::GfxActor::SortFlexbodies()
     std::sort(m_flexbodies.begin(), m_flexbodies.end(), [](FlexBody* a, FlexBody* b) { return a->size() > b->size(); });
 }
 
-void RoR::GfxActor::UpdateFlexbodies()
+bool RoR::GfxActor::NeedsFlexbodyDeform() const
+{
+    if (m_flexbody_deform_reset)
+        return true;
+
+    for (FlexBody* fb: m_flexbodies)
+    {
+        const int camera_mode = fb->getCameraMode();
+        if (((camera_mode == -2) || (camera_mode == m_simbuf.simbuf_cur_cinecam)) && !fb->HasDeformed())
+            return true;
+    }
+    return false;
+}
+
+void RoR::GfxActor::UpdateFlexbodies(bool deform)
 {
     m_flexbody_tasks.clear();
 
+    if (m_flexbody_deform_reset)
+    {
+        for (FlexBody* fb: m_flexbodies)
+        {
+            fb->ResetDeformation();
+        }
+        m_flexbody_deform_reset = false;
+    }
+
     for (FlexBody* fb: m_flexbodies)
     {
         const int camera_mode = fb->getCameraMode();
         if ((camera_mode == -2) || (camera_mode == m_simbuf.simbuf_cur_cinecam))
         {
+            if (!deform && fb->HasDeformed())
+            {
+                fb->ComputeFlexbodyRigid(); // Cheap, no task needed
+                continue;
+            }
             auto func = std::function<void()>([fb]()
                 {
                     fb->ComputeFlexbody();
@@ -3189,68 +3632,81 @@ void RoR::GfxActor::UpdateFlares(float dt_sec, bool is_player)
 
     bool enableAll = ((App::gfx_flares_mode->GetEnum<GfxFlaresMode>() == GfxFlaresMode::CURR_VEHICLE_HEAD_ONLY) && !is_player);
     SimBuffer::NodeSB* nodes = this->GetSimNodeBuffer();
+    const Ogre::Vector3 cam_pos = App::GetCameraManager()->GetCameraNode()->getPosition();
 
     int num_flares = static_cast<int>(m_actor->ar_flares.size());
     for (int i=0; i<num_flares; ++i)
     {
         flare_t& flare = m_actor->ar_flares[i];
-        
-        //TODO: Following code is a quick+dirty port from `Actor::updateFlares()` - tidy it up! ~only_a_ptr, 06/2018
 
-        if (flare.fl_type == FlareType::HEADLIGHT)
-        {
-            this->SetMaterialFlareOn(i, m_simbuf.simbuf_headlight_on);
-        }
-        else
+        // Material flares are expensive to update - only do it when the state changes.
+        const bool material_on = (flare.fl_type == FlareType::HEADLIGHT) ? m_simbuf.simbuf_headlight_on : flare.isVisible;
+        if (m_flare_material_on[i] != static_cast<int8_t>(material_on))
         {
-            this->SetMaterialFlareOn(i, flare.isVisible);
-            flare.snode->setVisible(flare.isVisible);
-            if (flare.light != nullptr)
-            {
-                flare.light->setVisible(flare.isVisible && enableAll);
-            }
+            this->SetMaterialFlareOn(i, material_on);
+            m_flare_material_on[i] = static_cast<int8_t>(material_on);
         }
 
         Ogre::Vector3 normal = (nodes[flare.nodey].AbsPosition - nodes[flare.noderef].AbsPosition).crossProduct(nodes[flare.nodex].AbsPosition - nodes[flare.noderef].AbsPosition);
         normal.normalise();
         Ogre::Vector3 mposition = nodes[flare.noderef].AbsPosition + flare.offsetx * (nodes[flare.nodex].AbsPosition - nodes[flare.noderef].AbsPosition) + flare.offsety * (nodes[flare.nodey].AbsPosition - nodes[flare.noderef].AbsPosition);
-        Ogre::Vector3 vdir = mposition - App::GetCameraManager()->GetCameraNode()->getPosition();
+        Ogre::Vector3 vdir = mposition - cam_pos;
         float vlen = vdir.length();
+        const bool light_wanted = flare.isVisible && (flare.fl_type == FlareType::HEADLIGHT || enableAll);
         // not visible from 500m distance
         if (vlen > 500.0)
         {
-            flare.snode->setVisible(false);
+            if (flare.bb)
+            {
+                flare.bb->setDimensions(0.f, 0.f);
+            }
+            if (flare.light)
+            {
+                this->SetFlareLightVisible(flare.light, false, vlen);
+            }
             continue;
         }
         //normalize
         vdir = vdir / vlen;
         float amplitude = normal.dotProduct(vdir);
-        flare.snode->setPosition(mposition - 0.1 * amplitude * normal * flare.offsetz);
-        flare.snode->setDirection(normal);
         float fsize = flare.size;
         if (fsize < 0)
         {
             amplitude = 1;
             fsize *= -1;
         }
+        if (flare.bb)
+        {
+            // Billboards live in a shared world-space set; hidden ones are collapsed to zero size.
+            flare.bb->setPosition(mposition - 0.1 * amplitude * normal * flare.offsetz);
+            const float bb_size = (flare.isVisible && amplitude > 0) ? (amplitude * fsize) : 0.f;
+            flare.bb->setDimensions(bb_size, bb_size);
+        }
         if (flare.light)
         {
             flare.light->setPosition(mposition - 0.2 * amplitude * normal);
             // point the real light towards the ground a bit
             flare.light->setDirection(-normal - Ogre::Vector3(0, 0.2, 0));
+            this->SetFlareLightVisible(flare.light, light_wanted, vlen);
         }
-        if (flare.isVisible)
-        {
-            if (amplitude > 0)
-            {
-                flare.bbs->setDefaultDimensions(amplitude * fsize, amplitude * fsize);
-                flare.snode->setVisible(true);
-            }
-            else
-            {
-                flare.snode->setVisible(false);
-            }
-        }
+    }
+
+    for (Ogre::BillboardSet* bbs: m_flare_billboard_sets)
+    {
+        bbs->_updateBounds();
+        bbs->getParentSceneNode()->needUpdate();
+    }
+}
+
+void RoR::GfxActor::SetFlareLightVisible(Ogre::Light* light, bool visible, float cam_distance)
+{
+    if (visible)
+    {
+        App::GetGfxScene()->AddFlareLight(light, cam_distance);
+    }
+    else if (light->getVisible())
+    {
+        light->setVisible(false);
     }
 }
 
@@ -3278,9 +3734,12 @@ void RoR::GfxActor::SetCastShadows(bool value)
     }
 
     // Softbody beams
-    for (Rod& rod: m_rods)
+    for (RodBatch& batch: m_rod_batches)
     {
-        static_cast<Ogre::Entity*>(rod.rod_scenenode->getAttachedObject(0))->setCastShadows(value);
+        if (batch.rb_entity != nullptr)
+        {
+            batch.rb_entity->setCastShadows(value);
+        }
     }
 
     // Flexbody meshes
@@ -202,11 +202,14 @@ public:
     bool                      IsActorInitialized () const  { return m_initialized; } //!< Temporary TODO: Remove once the spawn routine is fixed
     void                      InitializeActor    ()        { m_initialized = true; } //!< Temporary TODO: Remove once the spawn routine is fixed
     void                      UpdateSimDataBuffer(); //!< Copies sim. data from `Actor` to `GfxActor` for later update
+    void                      UpdateSimNodeBackBuffer(); //!< Called by the simulation thread at the end of physics step; picked up by `UpdateSimDataBuffer()`
+    void                      DiscardSimNodeBackBuffer() { m_simbuf_nodes_back_ready = false; m_flexbody_deform_reset = true; } //!< Call when nodes were moved outside of the physics step (reset/teleport/replay)
     void                      SetWheelVisuals    (uint16_t index, WheelGfx wheel_gfx);
     void                      CalculateDriverPos (Ogre::Vector3& out_pos, Ogre::Quaternion& out_rot);
-    void                      UpdateWheelVisuals ();
+    void                      UpdateWheelVisuals (bool deform = true); //!< @param deform False to keep last deformation (LOD)
     void                      FinishWheelUpdates ();
-    void                      UpdateFlexbodies   ();
+    void                      UpdateFlexbodies   (bool deform = true); //!< @param deform False to only move/rotate the last deformation (LOD)
+    bool                      NeedsFlexbodyDeform() const; //!< True if a visible flexbody wasn't deformed yet (or since a reset/teleport); LOD must not use rigid mode then
     void                      FinishFlexbodyTasks();
     void                      SetFlexbodyVisible (bool visible);
     void                      SetWheelsVisible   (bool value);
@@ -247,7 +250,7 @@ public:
     bool                 HasDriverSeatProp   () const { return m_driverseat_prop_index != -1; }
     void                 UpdateBeaconFlare   (Prop & prop, float dt, bool is_player_actor);
     void                 UpdateProps         (float dt, bool is_player_actor);
-    void                 UpdatePropAnimations(float dt, bool is_player_connected);
+    void                 UpdatePropAnimations(float dt, bool is_player_connected); //!< Pushes task to threadpool; finished by `UpdateProps()`
     void                 SetPropsVisible     (bool visible);
     void                 SetRenderdashActive (bool active);
     void                 UpdateRenderdashRTT ();
@@ -259,11 +262,18 @@ public:
 private:
 
     static Ogre::Quaternion SpecialGetRotationTo(const Ogre::Vector3& src, const Ogre::Vector3& dest);
+    void                    SetupRodBatchMesh(RodBatch& batch);
+    void                    CalcPropAnimations(float dt, bool is_player_connected);
+    void                    CalcPropTransforms();
+    void                    DisposeRodBatches();
+    void                    SetFlareLightVisible(Ogre::Light* light, bool visible, float cam_distance); //!< Visible lights are subject to `GfxScene::UpdateFlareLights()`
 
     Actor*                      m_actor;
 
     std::string                 m_custom_resource_group;
     std::vector<FlareMaterial>  m_flare_materials;
+    std::vector<int8_t>         m_flare_material_on;   //!< Last state applied by `SetMaterialFlareOn()` per flare; -1 = not applied yet
+    std::vector<Ogre::BillboardSet*> m_flare_billboard_sets; //!< Unique sets from `ar_flares`; owned by Actor
     VideoCamState               m_vidcam_state;
     std::vector<VideoCamera>    m_videocameras;
     DebugViewType               m_debug_view;
@@ -271,6 +281,10 @@ private:
     std::vector<NodeGfx>        m_gfx_nodes;
     std::vector<AirbrakeGfx>    m_gfx_airbrakes;
     std::vector<Prop>           m_props;
+    std::vector<PropTransform>  m_prop_transforms;
+    std::vector<PropAnimSource> m_prop_anim_sources;
+    std::vector<PropAnim*>      m_prop_anim_keyed;     //!< Animations with input events
+    std::shared_ptr<Task>       m_prop_anim_task;
     std::vector<FlexBody*>      m_flexbodies;
     int                         m_driverseat_prop_index;
     Attributes                  m_attr;
@@ -281,10 +295,12 @@ private:
     DustPool*                   m_particles_sparks;
     DustPool*                   m_particles_clump;
     std::vector<Rod>            m_rods;
+    std::vector<RodBatch>       m_rod_batches;
     std::vector<WheelGfx>       m_wheels;
     Ogre::SceneNode*            m_rods_parent_scenenode;
     RoR::Renderdash*            m_renderdash;
     std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
+    bool                        m_flexwheels_deformed = false;
     std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
     bool                        m_beaconlight_active;
     float                       m_prop_anim_crankfactor_prev;
@@ -295,6 +311,9 @@ private:
     bool                        m_initialized;
 
     SimBuffer                   m_simbuf;
+    std::unique_ptr<SimBuffer::NodeSB> m_simbuf_nodes_back;   //!< Written by the simulation thread, swapped with `m_simbuf.simbuf_nodes`
+    bool                        m_simbuf_nodes_back_ready = false;
+    bool                        m_flexbody_deform_reset = false; //!< Nodes were moved outside of the physics step; last flexbody deformations are stale
 
     // Old cab mesh
     FlexObj*                    m_cab_mesh;
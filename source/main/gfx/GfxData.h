@@ -30,6 +30,7 @@
 #include <Ogre.h>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace RoR {
 
@@ -87,6 +88,9 @@ inline PropAnimMode operator|=(PropAnimMode& dst, PropAnimMode const& arg) { dst
 
 struct PropAnim
 {
+    static const int SOURCE_NONE     = -1; //!< No input from `GfxActor::CalcPropAnimation()`
+    static const int SOURCE_STATEFUL = -2; //!< Evaluated per animation (torque, shifter)
+
     float        animratio    = 0;  //!< A coefficient for the animation, prop degree if used with mode: rotation and propoffset if used with mode: offset.
     PropAnimFlag animFlags    = {};
     PropAnimMode animMode     = {};
@@ -97,6 +101,25 @@ struct PropAnim
     int          lastanimKS   = 0;
     float        lower_limit  = 0;  //!< The lower limit for the animation
     float        upper_limit  = 0;  //!< The upper limit for the animation
+    int          animSourceIdx = SOURCE_NONE; //!< Index to `GfxActor::m_prop_anim_sources` or SOURCE_*
+    float        animKeyValue  = 0; //!< Input event value, buffered on main thread for the animation task
+};
+
+/// Distinct input of prop animations (flags + option3), evaluated once per frame for all props which use it.
+struct PropAnimSource
+{
+    int          pas_flags    = 0;
+    float        pas_option3  = 0;
+    float        pas_value    = 0;  //!< The resulting `cstate`
+};
+
+/// Scene node transforms of a prop, calculated by the animation task and applied on main thread.
+struct PropTransform
+{
+    Ogre::Vector3    pt_position          = Ogre::Vector3::ZERO;
+    Ogre::Quaternion pt_orientation       = Ogre::Quaternion::IDENTITY;
+    Ogre::Vector3    pt_wheel_position    = Ogre::Vector3::ZERO;        //!< Special prop - steering wheel
+    Ogre::Quaternion pt_wheel_orientation = Ogre::Quaternion::IDENTITY; //!< Special prop - steering wheel
 };
 
 /// A mesh attached to vehicle frame via 3 nodes
@@ -198,8 +221,6 @@ struct NodeGfx
 /// Visuals of softbody beam (`beam_t` struct); Partially updated along with SimBuffer
 struct Rod
 {
-    // We don't keep pointer to the Ogre::Entity - we rely on the SceneNode keeping it attached all the time.
-    Ogre::SceneNode* rod_scenenode       = nullptr;
     uint16_t         rod_beam_index      = 0;
     uint16_t         rod_diameter_mm     = 0;                    //!< Diameter in millimeters
 
@@ -209,6 +230,30 @@ struct Rod
     bool             rod_is_visible      = false;
 };
 
+/// Per-frame transform of a visible rod; unit axes + scale, see `GfxActor::UpdateRods()`
+struct RodInstance
+{
+    Ogre::Vector3    ri_center;
+    Ogre::Vector3    ri_axis_x;
+    Ogre::Vector3    ri_axis_y;
+    Ogre::Vector3    ri_axis_z;
+    float            ri_diameter;
+    float            ri_length;
+};
+
+/// All rods of an actor which share a material; drawn as a single dynamic mesh
+/// built by stamping the 'beam.mesh' geometry once per visible rod.
+struct RodBatch
+{
+    std::string                         rb_material_name;
+    std::vector<uint16_t>               rb_rods;                     //!< Indices into `GfxActor::m_rods`
+    std::vector<RodInstance>            rb_instances;                //!< Visible rods, refilled every frame
+    size_t                              rb_capacity          = 0;    //!< Number of rods the GPU buffers are sized for
+    Ogre::MeshPtr                       rb_mesh;
+    Ogre::Entity*                       rb_entity            = nullptr;
+    Ogre::HardwareVertexBufferSharedPtr rb_vertex_buf;
+};
+
 struct WheelGfx
 {
     Flexable*        wx_flex_mesh        = nullptr;
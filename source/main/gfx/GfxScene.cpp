@@ -38,6 +38,7 @@
 #include "TerrainObjectManager.h"
 
 #include <Ogre.h>
+#include <algorithm>
 
 using namespace Ogre;
 using namespace RoR;
@@ -66,6 +67,7 @@ void GfxScene::ClearScene()
     // Delete game elements
     m_all_gfx_actors.clear();
     m_all_gfx_characters.clear();
+    m_flare_lights.clear();
 
     // Wipe scene manager
     m_scene_manager->clearScene();
@@ -85,13 +87,6 @@ void RoR::GfxScene::Init()
 
 void RoR::GfxScene::UpdateScene(float dt_sec)
 {
-    // Actors - start threaded tasks
-    for (GfxActor* gfx_actor: m_live_gfx_actors)
-    {
-        gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
-        gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
-    }
-
     // Var
     GfxActor* player_gfx_actor = nullptr;
     std::set<GfxActor*> player_connected_gfx_actors;
@@ -101,6 +96,46 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
         player_connected_gfx_actors = player_gfx_actor->GetLinkedGfxActors();
     }
 
+    // Actors - start threaded tasks
+    // Flexbodies/flexwheels of distant or off-screen actors are deformed every Nth frame, or only moved rigidly.
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const Ogre::Vector3 camera_pos = App::GetCameraManager()->GetCameraNode()->_getDerivedPosition();
+    const unsigned int lod_interval = static_cast<unsigned int>(std::max(1, App::gfx_flexbody_lod_interval->GetInt()));
+    m_flexbody_lod_frame++;
+    for (GfxActor* gfx_actor: m_live_gfx_actors)
+    {
+        bool deform_flexbodies = true;
+        bool deform_wheels = true;
+        Ogre::AxisAlignedBox const& aabb = gfx_actor->GetSimDataBuffer().simbuf_aabb;
+        if (gfx_actor != player_gfx_actor && player_connected_gfx_actors.count(gfx_actor) == 0 && aabb.isFinite())
+        {
+            const float distance = aabb.distance(camera_pos);
+            const bool culled = App::gfx_flexbody_culling->GetBool() && !camera->isVisible(aabb);
+            const bool lod_frame = ((m_flexbody_lod_frame + gfx_actor->GetActorId()) % lod_interval) == 0; // Spread out among actors
+            if (culled || distance > App::gfx_flexbody_rigid_range->GetFloat())
+            {
+                deform_flexbodies = false;
+                deform_wheels = lod_frame; // No rigid mode for wheels, they'd lag behind
+            }
+            else if (distance > App::gfx_flexbody_lod_range->GetFloat())
+            {
+                deform_flexbodies = lod_frame;
+                deform_wheels = lod_frame;
+            }
+        }
+        if (!deform_flexbodies && gfx_actor->NeedsFlexbodyDeform())
+        {
+            deform_flexbodies = true; // Rigid mode needs a deformed mesh: first frame, or nodes were reset/teleported
+        }
+        gfx_actor->UpdateFlexbodies(deform_flexbodies); // Push flexbody tasks to threadpool
+        gfx_actor->UpdateWheelVisuals(deform_wheels); // Push flexwheel tasks to threadpool
+        if (gfx_actor->IsActorLive())
+        {
+            const bool is_player_connected = (gfx_actor == player_gfx_actor) || (player_connected_gfx_actors.count(gfx_actor) != 0);
+            gfx_actor->UpdatePropAnimations(dt_sec, is_player_connected); // Push prop task to threadpool; finished in `UpdateProps()`
+        }
+    }
+
     // FOV
     if (m_simbuf.simbuf_camera_behavior != CameraManager::CAMERA_BEHAVIOR_STATIC)
     {
@@ -207,7 +242,6 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
     // Actors - update misc visuals
     for (GfxActor* gfx_actor: m_all_gfx_actors)
     {
-        bool is_player_connected = (player_connected_gfx_actors.find(gfx_actor) != player_connected_gfx_actors.end());
         if (gfx_actor->IsActorLive())
         {
             gfx_actor->UpdateRods();
@@ -216,7 +250,6 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
             gfx_actor->UpdateAirbrakes();
             gfx_actor->UpdateCParticles();
             gfx_actor->UpdateAeroEngines();
-            gfx_actor->UpdatePropAnimations(dt_sec, (gfx_actor == player_gfx_actor) || is_player_connected);
             gfx_actor->UpdateRenderdashRTT();
         }
         // Beacon flares must always be updated
@@ -224,6 +257,7 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
         // Blinkers (turn signals) must always be updated
         gfx_actor->UpdateFlares(dt_sec, (gfx_actor == player_gfx_actor));
     }
+    this->UpdateFlareLights();
     if (player_gfx_actor != nullptr)
     {
         player_gfx_actor->UpdateVideoCameras(dt_sec);
@@ -251,6 +285,31 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
     }
 }
 
+void RoR::GfxScene::AddFlareLight(Ogre::Light* light, float cam_distance)
+{
+    m_flare_lights.push_back(std::make_pair(cam_distance, light));
+}
+
+void RoR::GfxScene::UpdateFlareLights()
+{
+    // Convoys of emergency vehicles can request hundreds of lights; only the nearest ones make a visible difference.
+    const size_t max_lights = static_cast<size_t>(std::max(0, App::gfx_flares_max_lights->GetInt()));
+    const size_t num_shown = std::min(max_lights, m_flare_lights.size());
+    std::partial_sort(m_flare_lights.begin(), m_flare_lights.begin() + num_shown, m_flare_lights.end(),
+        [](std::pair<float, Ogre::Light*> const& a, std::pair<float, Ogre::Light*> const& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < m_flare_lights.size(); ++i)
+    {
+        Ogre::Light* light = m_flare_lights[i].second;
+        const bool visible = (i < num_shown);
+        if (light->getVisible() != visible)
+        {
+            light->setVisible(visible);
+        }
+    }
+    m_flare_lights.clear();
+}
+
 void RoR::GfxScene::SetParticlesVisible(bool visible)
 {
     for (auto itor : m_dustpools)
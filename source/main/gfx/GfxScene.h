@@ -72,6 +72,7 @@ public:
     void           RemoveGfxActor(RoR::GfxActor* gfx_actor);
     void           RegisterGfxCharacter(RoR::GfxCharacter* gfx_character);
     void           RemoveGfxCharacter(RoR::GfxCharacter* gfx_character);
+    void           AddFlareLight(Ogre::Light* light, float cam_distance); //!< Requests the light to be visible this frame; see `UpdateFlareLights()`
     void           BufferSimulationData(); //!< Run this when simulation is halted
     SimBuffer&     GetSimDataBuffer() { return m_simbuf; }
     GfxEnvmap&     GetEnvMap() { return m_envmap; }
@@ -82,6 +83,8 @@ public:
 
 private:
 
+    void           UpdateFlareLights(); //!< Shows only the `gfx_flares_max_lights` nearest requested lights
+
     std::map<std::string, DustPool *> m_dustpools;
     Ogre::SceneManager*               m_scene_manager = nullptr;
     std::vector<GfxActor*>            m_all_gfx_actors;
@@ -90,6 +93,8 @@ private:
     RoR::GfxEnvmap                    m_envmap;
     SimBuffer                         m_simbuf;
     SkidmarkConfig                    m_skidmark_conf;
+    unsigned int                      m_flexbody_lod_frame = 0;   //!< Staggers reduced flexbody updates, see `UpdateScene()`
+    std::vector<std::pair<float, Ogre::Light*>> m_flare_lights;   //!< Lights requested this frame, with camera distance
 };
 
 } // namespace RoR
@@ -197,7 +197,7 @@ void GameSettings::Draw()
         DrawGCheckbox(App::gfx_speedo_digital, _LC("GameSettings", "Digital speedometer"));
         DrawGCheckbox(App::gfx_speedo_imperial, _LC("GameSettings", "Imperial speedometer"));
 
-        //DrawGCheckbox(App::gfx_flexbody_cache,     "Enable flexbody cache");
+        DrawGCheckbox(App::gfx_flexbody_cache, _LC("GameSettings", "Enable flexbody cache"));
 
         DrawGCheckbox(App::sim_spawn_running, _LC("GameSettings", "Engines spawn running"));
 
@@ -257,6 +257,11 @@ void GameSettings::Draw()
             "All vehicles, main lights\0"
             "All vehicles, all lights\0\0");
 
+        if (App::gfx_flares_mode->GetEnum<GfxFlaresMode>() > GfxFlaresMode::NO_LIGHTSOURCES)
+        {
+            DrawGIntSlider(App::gfx_flares_max_lights, _LC("GameSettings", "Max. light sources"), 0, 64);
+        }
+
         DrawGCombo(App::gfx_shadow_type, _LC("GameSettings", "Shadow type (requires restart)"),
             "Disabled\0"
             "PSSM\0\0");
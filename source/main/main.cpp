@@ -277,6 +277,7 @@ int main(int argc, char *argv[])
             if (App::app_state->GetEnum<AppState>() == AppState::SIMULATION)
             {
                 App::GetGameContext()->GetActorManager()->SyncWithSimThread();
+                App::GetGameContext()->UpdatePendingSpawns();
             }
 
             // Game events
@@ -516,6 +517,7 @@ int main(int argc, char *argv[])
                     }
                     App::GetGameContext()->SaveScene("autosave.sav");
                     App::GetGameContext()->ChangePlayerActor(nullptr);
+                    App::GetGameContext()->DiscardPendingSpawns();
                     App::GetGameContext()->GetActorManager()->CleanUpSimulation();
                     App::GetGameContext()->GetCharacterFactory()->DeleteAllCharacters();
                     App::GetGameContext()->GetSceneMouse().DiscardVisuals();
@@ -565,7 +567,15 @@ int main(int argc, char *argv[])
                     if (App::app_state->GetEnum<AppState>() == AppState::SIMULATION)
                     {
                         ActorSpawnRequest* rq = (ActorSpawnRequest*)m.payload;
-                        App::GetGameContext()->SpawnActor(*rq);
+                        if (rq->asr_origin == ActorSpawnRequest::Origin::USER ||
+                            rq->asr_origin == ActorSpawnRequest::Origin::NETWORK)
+                        {
+                            App::GetGameContext()->SpawnActorAsync(*rq); // Definition loads in background
+                        }
+                        else
+                        {
+                            App::GetGameContext()->SpawnActor(*rq); // Others (terrain, savegame) expect the actor to exist right away
+                        }
                         delete rq;
                     }
                     break;
@@ -68,6 +68,8 @@
 #include "VehicleAI.h"
 #include "Water.h"
 
+#include <set>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -192,18 +194,21 @@ Actor::~Actor()
     }
 
     // delete flares
+    std::set<Ogre::BillboardSet*> flare_billboard_sets; // Shared by flares, see `ActorSpawner::FindOrCreateFlareBillboardSet()`
     for (size_t i = 0; i < this->ar_flares.size(); i++)
     {
-        if (ar_flares[i].snode)
-        {
-            ar_flares[i].snode->removeAndDestroyAllChildren();
-            App::GetGfxScene()->GetSceneManager()->destroySceneNode(ar_flares[i].snode);
-        }
         if (ar_flares[i].bbs)
-            App::GetGfxScene()->GetSceneManager()->destroyBillboardSet(ar_flares[i].bbs);
+            flare_billboard_sets.insert(ar_flares[i].bbs);
         if (ar_flares[i].light)
             App::GetGfxScene()->GetSceneManager()->destroyLight(ar_flares[i].light);
     }
+    for (Ogre::BillboardSet* bbs: flare_billboard_sets)
+    {
+        Ogre::SceneNode* snode = bbs->getParentSceneNode();
+        App::GetGfxScene()->GetSceneManager()->destroyBillboardSet(bbs);
+        if (snode)
+            App::GetGfxScene()->GetSceneManager()->destroySceneNode(snode);
+    }
     this->ar_flares.clear();
 
     // delete exhausts
@@ -292,6 +297,7 @@ void Actor::ScaleActor(float value)
     if (value < 0)
         return;
     ar_scale *= value;
+    m_gfx_actor->DiscardSimNodeBackBuffer();
     // scale beams
     for (int i = 0; i < ar_num_beams; i++)
     {
@@ -1132,6 +1138,8 @@ void Actor::UpdatePhysicsOrigin()
 
 void Actor::ResetAngle(float rot)
 {
+    m_gfx_actor->DiscardSimNodeBackBuffer();
+
     // Set origin of rotation to camera node
     Vector3 origin = ar_nodes[ar_main_camera_node_pos].AbsPosition;
 
@@ -1162,6 +1170,8 @@ void Actor::UpdateInitPosition()
 
 void Actor::ResetPosition(float px, float pz, bool setInitPosition, float miny)
 {
+    m_gfx_actor->DiscardSimNodeBackBuffer();
+
     // horizontal displacement
     Vector3 offset = Vector3(px, ar_nodes[0].AbsPosition.y, pz) - ar_nodes[0].AbsPosition;
     for (int i = 0; i < ar_num_nodes; i++)
@@ -1220,6 +1230,8 @@ void Actor::ResetPosition(float px, float pz, bool setInitPosition, float miny)
 
 void Actor::ResetPosition(Vector3 translation, bool setInitPosition)
 {
+    m_gfx_actor->DiscardSimNodeBackBuffer();
+
     // total displacement
     if (translation != Vector3::ZERO)
     {
@@ -1494,6 +1506,7 @@ void Actor::SyncReset(bool reset_position)
     TRIGGER_EVENT(SE_TRUCK_RESET, ar_instance_id);
 
     m_reset_timer.reset();
+    m_gfx_actor->DiscardSimNodeBackBuffer();
 
     m_camera_local_gforces_cur = Vector3::ZERO;
     m_camera_local_gforces_max = Vector3::ZERO;
@@ -2935,12 +2948,7 @@ void Actor::ToggleLights()
         {
             if (ar_flares[i].fl_type == FlareType::HEADLIGHT)
             {
-                ar_flares[i].snode->setVisible(false);
-                if (ar_flares[i].bbs)
-                    ar_flares[i].snode->detachAllObjects();
-                if (ar_flares[i].light)
-                    ar_flares[i].light->setVisible(false);
-                ar_flares[i].isVisible = false;
+                ar_flares[i].isVisible = false; // 3D engine objects are updated in GfxActor
             }
         }
     }
@@ -2950,11 +2958,7 @@ void Actor::ToggleLights()
         {
             if (ar_flares[i].fl_type == FlareType::HEADLIGHT)
             {
-                if (ar_flares[i].light)
-                    ar_flares[i].light->setVisible(true);
-                ar_flares[i].isVisible = true;
-                if (ar_flares[i].bbs)
-                    ar_flares[i].snode->attachObject(ar_flares[i].bbs);
+                ar_flares[i].isVisible = true; // 3D engine objects are updated in GfxActor
             }
         }
     }
@@ -4526,7 +4530,7 @@ void Actor::setCustomLightVisible(int number, bool visible)
 
     unsigned int flareID = m_net_custom_lights[number];
 
-    if (flareID < ar_flares.size() && ar_flares[flareID].snode)
+    if (flareID < ar_flares.size() && ar_flares[flareID].bb)
     {
         ar_flares[flareID].controltoggle_status = visible;
     }
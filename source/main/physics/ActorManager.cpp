@@ -44,7 +44,10 @@
 #include "MovableText.h"
 #include "Network.h"
 #include "PointColDetector.h"
+#include "PlatformUtils.h"
 #include "Replay.h"
+#include "RigDef_BinarySerializer.h"
+#include "RigDef_Parser.h"
 #include "RigDef_Validator.h"
 #include "ActorSpawner.h"
 #include "ScriptEngine.h"
@@ -353,6 +356,7 @@ Actor* ActorManager::CreateActorInstance(ActorSpawnRequest rq, std::shared_ptr<R
 void ActorManager::RemoveStreamSource(int sourceid)
 {
     m_stream_mismatches.erase(sourceid);
+    m_unregistered_streams.erase(sourceid);
 
     for (auto actor : m_actors)
     {
@@ -366,6 +370,12 @@ void ActorManager::RemoveStreamSource(int sourceid)
     }
 }
 
+bool ActorManager::TakeUnregisteredStream(int sourceid, int streamid)
+{
+    auto found = m_unregistered_streams.find(sourceid);
+    return (found != m_unregistered_streams.end()) && (found->second.erase(streamid) > 0);
+}
+
 #ifdef USE_SOCKETW
 void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_buffer)
 {
@@ -483,7 +493,12 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
             {
                 App::GetGameContext()->PushMessage(Message(MSG_SIM_DELETE_ACTOR_REQUESTED, (void*)b));
             }
-            m_stream_mismatches[packet.header.source].erase(packet.header.streamid);
+            const bool was_mismatch = m_stream_mismatches[packet.header.source].erase(packet.header.streamid) > 0;
+            if (b == nullptr && !was_mismatch)
+            {
+                // The actor may still be loading (see `GameContext::SpawnActorAsync()`) - it must not be spawned afterwards.
+                m_unregistered_streams[packet.header.source].insert(packet.header.streamid);
+            }
         }
         else if (packet.header.command == RoRnet::MSG2_USER_LEAVE)
         {
@@ -1159,6 +1174,7 @@ void ActorManager::UpdatePhysicsSimulation()
             actor->m_avg_node_velocity /= (m_physics_steps * PHYSICS_DT);
             actor->m_avg_node_position_prev = actor->m_avg_node_position;
             actor->ar_top_speed = std::max(actor->ar_top_speed, actor->ar_nodes[0].Velocity.length());
+            actor->GetGfxActor()->UpdateSimNodeBackBuffer();
         }
     }
 }
@@ -1183,60 +1199,146 @@ void HandleErrorLoadingTruckfile(std::string filename, std::string exception_msg
 }
 
 std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(std::string filename, bool predefined_on_terrain)
+{
+    ActorDefLoad load;
+    load.filename = filename;
+    load.predefined_on_terrain = predefined_on_terrain;
+    if (!this->BeginFetchActorDef(load))
+    {
+        return (load.cache_entry != nullptr) ? load.cache_entry->actor_def : nullptr;
+    }
+    ActorManager::LoadActorDef(load);
+    return this->FinishFetchActorDef(load);
+}
+
+bool ActorManager::BeginFetchActorDef(ActorDefLoad& load)
 {
     // Find the user content
-    CacheEntry* cache_entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, filename);
-    if (cache_entry == nullptr)
+    load.cache_entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, load.filename);
+    if (load.cache_entry == nullptr)
     {
-        HandleErrorLoadingTruckfile(filename, "Truckfile not found in ModCache (probably not installed)");
-        return nullptr;
+        HandleErrorLoadingTruckfile(load.filename, "Truckfile not found in ModCache (probably not installed)");
+        return false;
     }
 
     // If already parsed, re-use
-    if (cache_entry->actor_def != nullptr)
+    if (load.cache_entry->actor_def != nullptr)
     {
-        return cache_entry->actor_def;
+        load.def = load.cache_entry->actor_def;
+        return false;
     }
 
-    // Load the 'truckfile'
     try
     {
-        Ogre::String resource_filename = filename;
-        Ogre::String resource_groupname;
-        if (!App::GetCacheSystem()->CheckResourceLoaded(resource_filename, resource_groupname)) // Validates the filename and finds resource group
+        Ogre::String resource_filename = load.filename;
+        if (!App::GetCacheSystem()->CheckResourceLoaded(resource_filename, load.resource_groupname)) // Validates the filename and finds resource group
         {
-            HandleErrorLoadingTruckfile(filename, "Truckfile not found");
-            return nullptr;
+            HandleErrorLoadingTruckfile(load.filename, "Truckfile not found");
+            return false;
         }
-        Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(resource_filename, resource_groupname);
 
-        if (stream.isNull() || !stream->isReadable())
+        // Look up the compiled definition - valid as long as the source ZIP/file is unchanged
+        const std::string source_path = CacheSystem::GetFingerprintPath(*load.cache_entry);
+        load.compiled_filename = CacheSystem::GetCompiledActorDefFilename(*load.cache_entry);
+        std::time_t source_time = 0;
+        load.has_fingerprint = RoR::GetFileSizeAndTime(source_path, load.source_size, source_time);
+        load.source_time = static_cast<int64_t>(source_time);
+        if (load.has_fingerprint)
         {
-            HandleErrorLoadingTruckfile(filename, "Unable to open/read truckfile");
-            return nullptr;
+            load.compiled_file = std::make_shared<MappedFile>();
+            if (!load.compiled_file->Open(PathCombine(App::sys_cache_dir->GetStr(), load.compiled_filename)))
+            {
+                load.compiled_file.reset();
+            }
+        }
+
+        // Only read the source if there's nothing compiled; it may be damaged or outdated, that's resolved in `FinishFetchActorDef()`.
+        if (load.compiled_file == nullptr)
+        {
+            return this->ReadActorDefSource(load);
+        }
+        return true;
+    }
+    catch (Ogre::Exception& oex)
+    {
+        HandleErrorLoadingTruckfile(load.filename, oex.getFullDescription().c_str());
+        return false;
+    }
+}
+
+bool ActorManager::ReadActorDefSource(ActorDefLoad& load)
+{
+    Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(load.filename, load.resource_groupname);
+    if (stream.isNull() || !stream->isReadable())
+    {
+        HandleErrorLoadingTruckfile(load.filename, "Unable to open/read truckfile");
+        return false;
+    }
+    load.source = stream->getAsString();
+    return true;
+}
+
+void ActorManager::LoadActorDef(ActorDefLoad& load)
+{
+    if (load.cancelled)
+    {
+        load.finished = true;
+        return;
+    }
+
+    try
+    {
+        RigDef::BinarySerializer::Fingerprint fingerprint(load.source_size, static_cast<std::time_t>(load.source_time));
+        if (load.compiled_file != nullptr)
+        {
+            load.def = RigDef::BinarySerializer::Deserialize(load.compiled_file->GetData(), load.compiled_file->GetSize(), fingerprint);
+            load.compiled_file.reset();
+            if (load.def != nullptr)
+            {
+                RoR::LogFormat("[RoR] Loaded compiled truckfile '%s'", load.filename.c_str());
+            }
         }
 
-        RoR::LogFormat("[RoR] Parsing truckfile '%s'", resource_filename.c_str());
-        RigDef::Parser parser;
-        parser.Prepare();
-        parser.ProcessOgreStream(stream.getPointer(), resource_groupname);
-        parser.Finalize();
+        if (load.def == nullptr)
+        {
+            if (load.source.empty())
+            {
+                load.finished = true;
+                return; // Outdated compiled definition - the source must be read on main thread first.
+            }
+
+            RoR::LogFormat("[RoR] Parsing truckfile '%s'", load.filename.c_str());
+            Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(&load.source[0], load.source.size(), /*freeOnClose=*/false, /*readOnly=*/true));
+            RigDef::Parser parser;
+            parser.SetCheckResources(false); // May run on a worker thread; checked in `FinishFetchActorDef()`
+            parser.Prepare();
+            parser.ProcessOgreStream(stream.getPointer(), load.resource_groupname);
+            parser.Finalize();
 
-        auto def = parser.GetFile();
+            load.def = parser.GetFile();
+            load.def->hash = Utils::Sha1Hash(load.source);
+            load.source.clear();
+
+            // Compile the definition before validation, which may modify it.
+            if (load.has_fingerprint)
+            {
+                RigDef::BinarySerializer::Serialize(*load.def, fingerprint, load.compiled_data);
+            }
+        }
 
         // VALIDATING
-        LOG(" == Validating vehicle: " + def->name);
+        LOG(" == Validating vehicle: " + load.def->name);
 
         RigDef::Validator validator;
-        validator.Setup(def);
+        validator.Setup(load.def);
 
-        if (predefined_on_terrain)
+        if (load.predefined_on_terrain)
         {
             // Workaround: Some terrains pre-load truckfiles with special purpose:
             //     "soundloads" = play sound effect at certain spot
             //     "fixes"      = structures of N/B fixed to the ground
             // These files can have no beams. Possible extensions: .load or .fixed
-            std::string file_extension = filename.substr(filename.find_last_of('.'));
+            std::string file_extension = load.filename.substr(load.filename.find_last_of('.'));
             Ogre::StringUtil::toLowerCase(file_extension);
             if ((file_extension == ".load") | (file_extension == ".fixed"))
             {
@@ -1245,27 +1347,123 @@ std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(std::string filename,
         }
 
         validator.Validate(); // Sends messages to console
-
-        def->hash = Utils::Sha1Hash(stream->getAsString());
-
-        cache_entry->actor_def = def;
-        return def;
     }
     catch (Ogre::Exception& oex)
     {
-        HandleErrorLoadingTruckfile(filename, oex.getFullDescription().c_str());
-        return nullptr;
+        load.def = nullptr;
+        load.error = oex.getFullDescription();
     }
     catch (std::exception& stex)
     {
-        HandleErrorLoadingTruckfile(filename, stex.what());
-        return nullptr;
+        load.def = nullptr;
+        load.error = stex.what();
     }
     catch (...)
     {
-        HandleErrorLoadingTruckfile(filename, "<Unknown exception occurred>");
+        load.def = nullptr;
+        load.error = "<Unknown exception occurred>";
+    }
+    load.finished = true;
+}
+
+std::shared_ptr<RigDef::File> ActorManager::FinishFetchActorDef(ActorDefLoad& load)
+{
+    if (!load.error.empty())
+    {
+        HandleErrorLoadingTruckfile(load.filename, load.error);
         return nullptr;
     }
+
+    // Another request for the same truckfile may have finished first
+    if (load.cache_entry->actor_def != nullptr)
+    {
+        return load.cache_entry->actor_def;
+    }
+
+    if (load.def == nullptr)
+    {
+        // The compiled definition was outdated or damaged - parse synchronously
+        try
+        {
+            if (!this->ReadActorDefSource(load))
+            {
+                return nullptr;
+            }
+        }
+        catch (Ogre::Exception& oex)
+        {
+            HandleErrorLoadingTruckfile(load.filename, oex.getFullDescription().c_str());
+            return nullptr;
+        }
+        ActorManager::LoadActorDef(load);
+        if (!load.error.empty())
+        {
+            HandleErrorLoadingTruckfile(load.filename, load.error);
+            return nullptr;
+        }
+    }
+
+    if (!load.compiled_data.empty())
+    {
+        try
+        {
+            Ogre::DataStreamPtr compiled_stream = Ogre::ResourceGroupManager::getSingleton().createResource(
+                load.compiled_filename, RGN_CACHE, /*overwrite=*/true);
+            compiled_stream->write(load.compiled_data.data(), load.compiled_data.size());
+        }
+        catch (Ogre::Exception& e)
+        {
+            RoR::LogFormat("[RoR] Error writing compiled truckfile '%s', message: %s",
+                load.compiled_filename.c_str(), e.getFullDescription().c_str());
+        }
+        load.compiled_data.clear();
+    }
+
+    ActorManager::CheckManagedMaterialTextures(*load.def, load.resource_groupname);
+
+    load.cache_entry->actor_def = load.def;
+    return load.def;
+}
+
+void ActorManager::CheckManagedMaterialTextures(RigDef::File& def, std::string const& resource_group)
+{
+    // The parser does this unless told otherwise (see `RigDef::Parser::SetCheckResources()`); here it's done on main thread
+    // for definitions parsed on a worker thread, and for compiled ones which are stored unchecked.
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    std::vector<std::shared_ptr<RigDef::File::Module>> modules;
+    modules.push_back(def.root_module);
+    for (auto& entry : def.user_modules)
+    {
+        modules.push_back(entry.second);
+    }
+
+    for (auto& module : modules)
+    {
+        auto itor = module->managed_materials.begin();
+        while (itor != module->managed_materials.end())
+        {
+            if (!rgm.resourceExists(resource_group, itor->diffuse_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    def.name + " (managedmaterial '" + itor->name + "'): Missing texture file: " + itor->diffuse_map);
+                itor = module->managed_materials.erase(itor);
+                continue;
+            }
+            if (itor->HasDamagedDiffuseMap() && !rgm.resourceExists(resource_group, itor->damaged_diffuse_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    def.name + " (managedmaterial '" + itor->name + "'): Missing texture file: " + itor->damaged_diffuse_map);
+                itor->damaged_diffuse_map = "-";
+            }
+            if (itor->HasSpecularMap() && !rgm.resourceExists(resource_group, itor->specular_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    def.name + " (managedmaterial '" + itor->name + "'): Missing texture file: " + itor->specular_map);
+                itor->specular_map = "-";
+            }
+            ++itor;
+        }
+    }
 }
 
 std::vector<Actor*> ActorManager::GetLocalActors()
@@ -32,6 +32,8 @@
 #include "RigDef_Prerequisites.h"
 #include "ThreadPool.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,6 +41,32 @@
 
 namespace RoR {
 
+class MappedFile;
+
+/// Loading of an actor definition, split into stages so the costly part (parsing, validating) can run on a worker thread.
+/// See `ActorManager::BeginFetchActorDef()`, `ActorManager::LoadActorDef()` and `ActorManager::FinishFetchActorDef()`.
+struct ActorDefLoad
+{
+    // Input (main thread)
+    std::string                   filename;
+    bool                          predefined_on_terrain = false;
+    CacheEntry*                   cache_entry = nullptr;
+    std::string                   resource_groupname;
+    std::string                   compiled_filename;
+    std::shared_ptr<MappedFile>   compiled_file;          //!< Compiled definition, if present in cache.
+    std::string                   source;                 //!< Contents of the truckfile; only read if compiled definition is missing.
+    uint64_t                      source_size = 0;        //!< Fingerprint of the source ZIP/file
+    int64_t                       source_time = 0;        //!< Fingerprint of the source ZIP/file
+    bool                          has_fingerprint = false;
+
+    // Output (any thread)
+    std::shared_ptr<RigDef::File> def;
+    std::vector<char>             compiled_data;          //!< Compiled definition to be saved to cache, if it was parsed.
+    std::string                   error;
+    std::atomic<bool>             finished{false};
+    std::atomic<bool>             cancelled{false};       //!< Set by main thread; a load which didn't start yet is skipped.
+};
+
 /// Builds and manages softbody actors (physics on background thread, networking)
 class ActorManager
 {
@@ -57,6 +85,7 @@ public:
     int            GetNetTimeOffset(int sourceid);
     void           UpdateNetTimeOffset(int sourceid, int offset);
     void           AddStreamMismatch(int sourceid, int streamid) { m_stream_mismatches[sourceid].insert(streamid); };
+    bool           TakeUnregisteredStream(int sourceid, int streamid); //!< True if the stream was unregistered before its actor was spawned; forgets it.
     int            CheckNetworkStreamsOk(int sourceid);
     int            CheckNetRemoteStreamsOk(int sourceid);
     void           MuteAllActors();
@@ -80,7 +109,10 @@ public:
     Actor*         GetActorById(int actor_id);
     Actor*         FindActorInsideBox(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box);
     void           UpdateInputEvents(float dt);
-    std::shared_ptr<RigDef::File>   FetchActorDef(std::string filename, bool predefined_on_terrain = false);
+    std::shared_ptr<RigDef::File>   FetchActorDef(std::string filename, bool predefined_on_terrain = false); //!< Loads synchronously; all stages below at once.
+    bool                            BeginFetchActorDef(ActorDefLoad& load);  //!< Main thread; returns false if nothing more to do (already loaded or error, which is reported).
+    static void                     LoadActorDef(ActorDefLoad& load);        //!< Thread-safe, doesn't touch OGRE resources or the cache.
+    std::shared_ptr<RigDef::File>   FinishFetchActorDef(ActorDefLoad& load); //!< Main thread; reports errors, saves compiled definition to cache.
 
 #ifdef USE_SOCKETW
     void           HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet);
@@ -108,6 +140,8 @@ public:
 private:
 
     void           SetupActor(Actor* actor, ActorSpawnRequest rq, std::shared_ptr<RigDef::File> def);
+    bool           ReadActorDefSource(ActorDefLoad& load);        //!< Main thread; OGRE resource system isn't thread-safe.
+    static void    CheckManagedMaterialTextures(RigDef::File& def, std::string const& resource_group); //!< Main thread; drops managed materials whose diffuse map is missing.
     bool           CheckActorCollAabbIntersect(int a, int b);    //!< Returns whether or not the bounding boxes of truck a and truck b intersect. Based on the truck collision bounding boxes.
     bool           PredictActorCollAabbIntersect(int a, int b);  //!< Returns whether or not the bounding boxes of truck a and truck b might intersect during the next framestep. Based on the truck collision bounding boxes.
     void           RemoveStreamSource(int sourceid);
@@ -117,6 +151,7 @@ private:
 
     // Networking
     std::map<int, std::set<int>> m_stream_mismatches; //!< Networking: A set of streams without a corresponding actor in the actor-array for each stream source
+    std::map<int, std::set<int>> m_unregistered_streams; //!< Networking: Streams unregistered while their actor was still loading, see `GameContext::UpdatePendingSpawns()`
     std::map<int, int>  m_stream_time_offsets;       //!< Networking: A network time offset for each stream source
     Ogre::Timer         m_net_timer;
 
@@ -2002,6 +2002,32 @@ void ActorSpawner::ProcessProp(RigDef::Prop & def)
     m_props.push_back(prop);
 }
 
+Ogre::BillboardSet* ActorSpawner::FindOrCreateFlareBillboardSet(std::string const & material_name)
+{
+    auto found = m_flare_billboard_sets.find(material_name);
+    if (found != m_flare_billboard_sets.end())
+    {
+        return found->second;
+    }
+
+    Ogre::MaterialPtr material = this->FindOrCreateCustomizedMaterial(material_name);
+    if (material.isNull())
+    {
+        return nullptr;
+    }
+
+    // Billboards are positioned in world space, the scene node stays at origin.
+    std::string set_name = this->ComposeName("FlareSet", static_cast<int>(m_flare_billboard_sets.size()));
+    Ogre::BillboardSet* bbs = App::GetGfxScene()->GetSceneManager()->createBillboardSet(set_name, 4);
+    bbs->setAutoextend(true);
+    bbs->setVisibilityFlags(DEPTHMAP_DISABLED);
+    bbs->setMaterial(material);
+    App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode()->attachObject(bbs);
+
+    m_flare_billboard_sets.insert(std::make_pair(material_name, bbs));
+    return bbs;
+}
+
 void ActorSpawner::ProcessFlare2(RigDef::Flare2 & def)
 {
     if (m_actor->m_flares_mode == GfxFlaresMode::NONE) { return; }
@@ -2047,41 +2073,34 @@ void ActorSpawner::ProcessFlare2(RigDef::Flare2 & def)
     flare.size                 = size;
 
     /* Visuals */
-    flare.snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
     std::string flare_name = this->ComposeName("Flare", static_cast<int>(m_actor->ar_flares.size()));
-    flare.bbs = App::GetGfxScene()->GetSceneManager()->createBillboardSet(flare_name, 1);
-    bool using_default_material = true;
+    std::string material_name = def.material_name;
+    bool using_default_material = (material_name.length() == 0 || material_name == "default");
+    if (using_default_material)
+    {
+        if (def.type == RigDef::Flare2::TYPE_b_BRAKELIGHT)
+        {
+            material_name = "tracks/brakeflare";
+        }
+        else if (def.type == RigDef::Flare2::TYPE_l_LEFT_BLINKER || (def.type == RigDef::Flare2::TYPE_r_RIGHT_BLINKER))
+        {
+            material_name = "tracks/blinkflare";
+        }
+        else
+        {
+            material_name = "tracks/flare";
+        }
+    }
+    flare.bbs = this->FindOrCreateFlareBillboardSet(material_name);
+    flare.bb = nullptr;
     if (flare.bbs == nullptr)
     {
         AddMessage(Message::TYPE_WARNING, "Failed to create flare: '" + flare_name + "', continuing without it (compatibility)...");
     }
     else
     {
-        flare.bbs->createBillboard(0,0,0);
-        flare.bbs->setVisibilityFlags(DEPTHMAP_DISABLED);
-        std::string material_name = def.material_name;
-        using_default_material = (material_name.length() == 0 || material_name == "default");
-        if (using_default_material)
-        {
-            if (def.type == RigDef::Flare2::TYPE_b_BRAKELIGHT)
-            {
-                material_name = "tracks/brakeflare";
-            }
-            else if (def.type == RigDef::Flare2::TYPE_l_LEFT_BLINKER || (def.type == RigDef::Flare2::TYPE_r_RIGHT_BLINKER))
-            {
-                material_name = "tracks/blinkflare";
-            }
-            else
-            {
-                material_name = "tracks/flare";
-            }
-        }
-        Ogre::MaterialPtr material = this->FindOrCreateCustomizedMaterial(material_name);
-        if (!material.isNull())
-        {
-            flare.bbs->setMaterial(material);
-            flare.snode->attachObject(flare.bbs);
-        }
+        flare.bb = flare.bbs->createBillboard(0,0,0);
+        flare.bb->setDimensions(0.f, 0.f); // Hidden until first update, see `GfxActor::UpdateFlares()`
     }
     flare.isVisible = true;
     flare.light = nullptr;
@@ -923,6 +923,12 @@ private:
 
     Ogre::ParticleSystem* CreateParticleSystem(std::string const & name, std::string const & template_name);
 
+    /**
+    * Flares are batched: 1 world-space billboard set per material per actor.
+    * @return NULL if the material could not be found.
+    */
+    Ogre::BillboardSet* FindOrCreateFlareBillboardSet(std::string const & material_name);
+
     RigDef::MaterialFlareBinding* FindFlareBindingForMaterial(std::string const & material_name); //!< Returns NULL if none found
 
     RigDef::VideoCamera* FindVideoCameraByMaterial(std::string const & material_name); //!< Returns NULL if none found
@@ -1081,6 +1087,7 @@ private:
     std::vector<BeamVisualsTicket>         m_beam_visuals_queue; //!< We want to spawn visuals asynchronously in the future
     std::vector<WheelVisualsTicket>        m_wheel_visuals_queue; //!< We want to spawn visuals asynchronously in the future
     std::map<std::string, Ogre::MaterialPtr>  m_managed_materials;
+    std::map<std::string, Ogre::BillboardSet*> m_flare_billboard_sets; //!< Keyed by original material name
     std::list<std::shared_ptr<RigDef::File::Module>>  m_selected_modules;
 
 };
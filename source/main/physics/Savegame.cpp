@@ -30,6 +30,7 @@
 #include "Console.h"
 #include "EngineSim.h"
 #include "GameContext.h"
+#include "GfxActor.h"
 #include "GUIManager.h"
 #include "InputEngine.h"
 #include "Language.h"
@@ -865,6 +866,7 @@ void ActorManager::RestoreSavedState(Actor* actor, rapidjson::Value const& j_ent
         }
     }
 
+    actor->GetGfxActor()->DiscardSimNodeBackBuffer();
     auto nodes = j_entry["nodes"].GetArray();
     for (rapidjson::SizeType i = 0; i < nodes.Size(); i++)
     {
@@ -533,8 +533,8 @@ struct flare_t
     float offsetx;
     float offsety;
     float offsetz;
-    Ogre::SceneNode *snode;
-    Ogre::BillboardSet *bbs;
+    Ogre::BillboardSet *bbs;   //!< Shared by all flares of the actor which use the same material.
+    Ogre::Billboard *bb;       //!< Positioned in world space.
     Ogre::Light *light;
     FlareType fl_type;
     int controlnumber;
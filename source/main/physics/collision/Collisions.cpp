@@ -25,6 +25,7 @@
 #include "ApproxMath.h"
 #include "Actor.h"
 #include "ActorManager.h"
+#include "CacheSystem.h"
 #include "ErrorUtils.h"
 #include "GameContext.h"
 #include "GfxScene.h"
@@ -34,6 +35,16 @@
 #include "PlatformUtils.h"
 #include "ScriptEngine.h"
 #include "TerrainManager.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ROR_COLLISIONS_SSE2
+#   include <emmintrin.h>
+#endif
 
 using namespace RoR;
 
@@ -115,6 +126,155 @@ unsigned int sbox[] =
 using namespace Ogre;
 using namespace RoR;
 
+// Collision cache file, see `Collisions::setupCollisionCache()`
+static const char*    COLLISION_CACHE_SIGNATURE = "RoR Collisions";
+static const size_t   COLLISION_CACHE_SIGNATURE_LENGTH = 16;
+static const uint32_t COLLISION_CACHE_FORMAT_VERSION = 2; // 2 = per-mesh source fingerprint
+
+struct CollisionCacheHeader
+{
+    char     signature[COLLISION_CACHE_SIGNATURE_LENGTH];
+    uint32_t file_format_version;
+    uint32_t num_gm_names;
+    uint32_t num_meshes;
+    uint32_t num_tris;
+    uint64_t source_size; //!< Fingerprint of the terrain ZIP/file
+    int64_t  source_time; //!< Fingerprint of the terrain ZIP/file
+};
+
+/// Bounds-checked reading from the mapped cache file
+struct CollisionCacheReader
+{
+    const char* pos;
+    const char* end;
+
+    const char* Map(size_t length) //!< Returns nullptr if the file is truncated
+    {
+        if (static_cast<size_t>(end - pos) < length)
+            return nullptr;
+        const char* result = pos;
+        pos += length;
+        return result;
+    }
+
+    bool ReadString(std::string& out) //!< Length-prefixed, padded to 4 bytes
+    {
+        const char* len_ptr = this->Map(sizeof(uint32_t));
+        if (!len_ptr)
+            return false;
+        uint32_t len;
+        std::memcpy(&len, len_ptr, sizeof(uint32_t));
+        const char* str = this->Map((len + 3) & ~3u);
+        if (!str)
+            return false;
+        out.assign(str, len);
+        return true;
+    }
+};
+
+static void CacheAppend(std::vector<char>& buf, const void* data, size_t length)
+{
+    const char* bytes = static_cast<const char*>(data);
+    buf.insert(buf.end(), bytes, bytes + length);
+}
+
+static void CacheAppendString(std::vector<char>& buf, std::string const& str)
+{
+    const uint32_t len = static_cast<uint32_t>(str.size());
+    CacheAppend(buf, &len, sizeof(uint32_t));
+    CacheAppend(buf, str.data(), len);
+    buf.resize(buf.size() + (((len + 3) & ~3u) - len), '\0');
+}
+
+static void CacheWriteVector3(float* out, Vector3 const& v)
+{
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+static Vector3 CacheReadVector3(const float* in)
+{
+    return Vector3(in[0], in[1], in[2]);
+}
+
+static void CacheWriteMatrix3(float* out, Matrix3 const& m)
+{
+    for (int row = 0; row < 3; row++)
+    {
+        for (int col = 0; col < 3; col++)
+        {
+            out[row * 3 + col] = m[row][col];
+        }
+    }
+}
+
+static Matrix3 CacheReadMatrix3(const float* in)
+{
+    return Matrix3(in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], in[8]);
+}
+
+/// Size and mtime of the ZIP/file the mesh is loaded from; meshes are often shared from other bundles than the terrain's.
+/// Returns false if the source can't be determined - the mesh is then never taken from the cache.
+static bool GetCollisionMeshFingerprint(const Ogre::String& meshname, uint64_t& out_size, int64_t& out_time)
+{
+    out_size = 0;
+    out_time = 0;
+    try
+    {
+        const Ogre::String group = ResourceGroupManager::getSingleton().findGroupContainingResource(meshname);
+        FileInfoListPtr files = ResourceGroupManager::getSingleton().findResourceFileInfo(group, meshname);
+        if (files->empty() || files->front().archive == nullptr)
+        {
+            return false;
+        }
+        const Archive* archive = files->front().archive;
+        const std::string path = (archive->getType() == "FileSystem")
+            ? PathCombine(archive->getName(), files->front().filename)
+            : archive->getName();
+        std::time_t mtime = 0;
+        if (!RoR::GetFileSizeAndTime(path, out_size, mtime))
+        {
+            return false;
+        }
+        out_time = static_cast<int64_t>(mtime);
+        return true;
+    }
+    catch (Ogre::Exception&)
+    {
+        return false;
+    }
+}
+
+/// Builds mesh-space collision tris; touches nothing but 'cmesh', so it's safe to run on worker threads.
+static void TriangulateCollisionMesh(collision_mesh_t& cmesh, const Vector3* vertices, size_t index_count, const unsigned* indices)
+{
+    cmesh.tris.reserve(index_count / 3);
+    for (int i=0; i<(int)index_count/3; i++)
+    {
+        collision_tri_t ltri;
+        ltri.a = vertices[indices[i*3]];
+        ltri.b = vertices[indices[i*3+1]];
+        ltri.c = vertices[indices[i*3+2]];
+        ltri.gm = nullptr;
+        ltri.enabled = true;
+        // same base construction as in `addCollisionTri()`, but in mesh space
+        Vector3 bx=ltri.b-ltri.a;
+        Vector3 by=ltri.c-ltri.a;
+        Vector3 bz=bx.crossProduct(by);
+        bz.normalise();
+        ltri.reverse.SetColumn(0, bx);
+        ltri.reverse.SetColumn(1, by);
+        ltri.reverse.SetColumn(2, bz);
+        ltri.forward=ltri.reverse.Inverse();
+
+        cmesh.aab.merge(ltri.a);
+        cmesh.aab.merge(ltri.b);
+        cmesh.aab.merge(ltri.c);
+        cmesh.tris.push_back(ltri);
+    }
+}
+
 Collisions::Collisions(Ogre::Vector3 terrn_size):
       debugMode(false)
     , debugmo(nullptr)
@@ -125,6 +285,7 @@ Collisions::Collisions(Ogre::Vector3 terrn_size):
     , m_terrain_size(terrn_size)
 {
     debugMode = App::diag_collisions->GetBool(); // TODO: make interactive - do not copy the value, use GVar directly
+    std::fill(hashtable_box_bucket, hashtable_box_bucket + HASH_SIZE, -1);
     for (int i=0; i < HASH_POWER; i++)
     {
         hashmask = hashmask << 1;
@@ -338,7 +499,7 @@ Ogre::Vector3 Collisions::calcCollidedSide(const Ogre::Vector3& pos, const Ogre:
 void Collisions::setupLandUse(const char *configfile)
 {
     if (landuse) return;
-    landuse = new Landusemap(configfile);
+    landuse = new Landusemap(configfile, m_landuse_cache_filename, m_cache_source_size, m_cache_source_time);
 }
 
 void Collisions::removeCollisionBox(int number)
@@ -363,6 +524,14 @@ void Collisions::removeCollisionTri(int number)
     }
 }
 
+void Collisions::removeCollisionMeshInstance(int number)
+{
+    if (number > -1 && number < m_collision_mesh_instances.size())
+    {
+        m_collision_mesh_instances[number].enabled = false;
+    }
+}
+
 ground_model_t *Collisions::getGroundModelByString(const String name)
 {
     if (!ground_models.size() || ground_models.find(name) == ground_models.end())
@@ -632,6 +801,8 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
         }
     }
 
+    m_collision_boxes.push_back(coll_box);
+
     // register this collision box in the index
     Vector3 ilo = Ogre::Vector3(coll_box.lo / Ogre::Real(CELL_SIZE));
     Vector3 ihi = Ogre::Vector3(coll_box.hi / Ogre::Real(CELL_SIZE));
@@ -647,14 +818,178 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
         for (int j = ilo.z; j <= ihi.z; j++)
         {
             hash_add(i, j, coll_box_index,coll_box.hi.y);
+            addBoxToPacks(i, j, coll_box_index);
         }
     }
 
     m_collision_aab.merge(AxisAlignedBox(coll_box.lo, coll_box.hi));
-    m_collision_boxes.push_back(coll_box);
     return coll_box_index;
 }
 
+void Collisions::addBoxToPacks(int cell_x, int cell_z, int box_index)
+{
+    unsigned int cell_id = (cell_x << 16) + cell_z;
+    unsigned int pos    = hashfunc(cell_id);
+
+    if (hashtable_box_bucket[pos] == -1)
+    {
+        hashtable_box_bucket[pos] = static_cast<int>(m_box_buckets.size());
+        m_box_buckets.emplace_back();
+    }
+    collision_box_bucket_t& bucket = m_box_buckets[hashtable_box_bucket[pos]];
+    const collision_box_t& cbox = m_collision_boxes[box_index];
+
+    if (!cbox.virt || cbox.camforced)
+    {
+        addBoxToPack(bucket.solid_packs, cell_id, box_index, cbox);
+    }
+    if (cbox.eventsourcenum != -1 || cbox.camforced)
+    {
+        addBoxToPack(bucket.event_packs, cell_id, box_index, cbox);
+    }
+}
+
+void Collisions::addBoxToPack(std::vector<collision_box_pack_t>& packs, unsigned int cell_id, int box_index, const collision_box_t& cbox)
+{
+    if (packs.empty() || packs.back().num_boxes == collision_box_pack_t::NUM_LANES)
+    {
+        collision_box_pack_t pack;
+        for (int i = 0; i < collision_box_pack_t::NUM_LANES; i++)
+        {
+            pack.center_x[i] = pack.center_y[i] = pack.center_z[i] = 0.f;
+            pack.half_x[i] = pack.half_y[i] = pack.half_z[i] = -1.f;
+            for (int r = 0; r < 9; r++)
+            {
+                pack.rot[r][i] = 0.f;
+            }
+            pack.cell_id[i] = 0;
+            pack.box_index[i] = -1;
+        }
+        pack.num_boxes = 0;
+        packs.push_back(pack);
+    }
+    collision_box_pack_t& pack = packs.back();
+    const int lane = pack.num_boxes++;
+
+    // Same change of repere as in `nodeCollision()`: pos' = selfunrot * (unrot * (pos - center) - selfcenter) + selfcenter
+    // Since 'selfcenter' is the middle of the refined box, the OBB is centered on it.
+    Matrix3 rot = Matrix3::IDENTITY;
+    if (cbox.refined)
+    {
+        cbox.unrot.ToRotationMatrix(rot);
+    }
+    if (cbox.selfrotated)
+    {
+        Matrix3 selfrot;
+        cbox.selfunrot.ToRotationMatrix(selfrot);
+        rot = selfrot * rot;
+    }
+    const Vector3 center = (cbox.refined) ? (cbox.center + cbox.rot * cbox.selfcenter) : (cbox.center + cbox.selfcenter);
+    const Vector3 half = (cbox.rehi - cbox.relo) * 0.5f;
+
+    pack.center_x[lane] = center.x;
+    pack.center_y[lane] = center.y;
+    pack.center_z[lane] = center.z;
+    pack.half_x[lane] = half.x;
+    pack.half_y[lane] = half.y;
+    pack.half_z[lane] = half.z;
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            pack.rot[r * 3 + c][lane] = rot[r][c];
+        }
+    }
+    pack.cell_id[lane] = cell_id;
+    pack.box_index[lane] = box_index;
+}
+
+int Collisions::testBoxPack(const collision_box_pack_t& pack, const Vector3& pos, unsigned int cell_id)
+{
+    const float* half[3] = { pack.half_x, pack.half_y, pack.half_z };
+#ifdef ROR_COLLISIONS_SSE2
+    const __m128 dx = _mm_sub_ps(_mm_set1_ps(pos.x), _mm_loadu_ps(pack.center_x));
+    const __m128 dy = _mm_sub_ps(_mm_set1_ps(pos.y), _mm_loadu_ps(pack.center_y));
+    const __m128 dz = _mm_sub_ps(_mm_set1_ps(pos.z), _mm_loadu_ps(pack.center_z));
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 inside = _mm_castsi128_ps(_mm_cmpeq_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pack.cell_id)), _mm_set1_epi32(static_cast<int>(cell_id))));
+    for (int r = 0; r < 3; r++)
+    {
+        __m128 d = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_loadu_ps(pack.rot[r * 3 + 0]), dx),
+            _mm_mul_ps(_mm_loadu_ps(pack.rot[r * 3 + 1]), dy)),
+            _mm_mul_ps(_mm_loadu_ps(pack.rot[r * 3 + 2]), dz));
+        inside = _mm_and_ps(inside, _mm_cmplt_ps(_mm_and_ps(d, abs_mask), _mm_loadu_ps(half[r])));
+    }
+    return _mm_movemask_ps(inside);
+#else
+    int result = 0;
+    for (int i = 0; i < collision_box_pack_t::NUM_LANES; i++)
+    {
+        if (pack.cell_id[i] != cell_id)
+            continue;
+
+        const float dx = pos.x - pack.center_x[i];
+        const float dy = pos.y - pack.center_y[i];
+        const float dz = pos.z - pack.center_z[i];
+        bool inside = true;
+        for (int r = 0; r < 3 && inside; r++)
+        {
+            const float d = pack.rot[r * 3 + 0][i] * dx + pack.rot[r * 3 + 1][i] * dy + pack.rot[r * 3 + 2][i] * dz;
+            inside = std::fabs(d) < half[r][i];
+        }
+        if (inside)
+            result |= (1 << i);
+    }
+    return result;
+#endif // ROR_COLLISIONS_SSE2
+}
+
+Vector3 Collisions::calcBoxCollisionNormal(const collision_box_t* cbox, const Vector3& pos)
+{
+    // determine which side collided
+    Vector3 Pos = pos;
+    Vector3 lo = cbox->lo;
+    Vector3 hi = cbox->hi;
+    if (cbox->refined || cbox->selfrotated)
+    {
+        // do a change of repere
+        Pos = pos - cbox->center;
+        if (cbox->refined)
+        {
+            Pos = cbox->unrot * Pos;
+        }
+        if (cbox->selfrotated)
+        {
+            Pos = Pos - cbox->selfcenter;
+            Pos = cbox->selfunrot * Pos;
+            Pos = Pos + cbox->selfcenter;
+        }
+        lo = cbox->relo;
+        hi = cbox->rehi;
+    }
+
+    float t = hi.z - Pos.z;
+    float min = Pos.z - lo.z;
+    Vector3 normal = Vector3(0, 0, -1);
+    if (t < min) { min = t; normal = Vector3(0,0,1);}; //north
+    t = Pos.x - lo.x;
+    if (t < min) { min = t; normal = Vector3(-1,0,0);}; //west
+    t = hi.x - Pos.x;
+    if (t < min) { min = t; normal = Vector3(1,0,0);}; //east
+    t = Pos.y - lo.y;
+    if (t < min) { min = t; normal = Vector3(0,-1,0);}; //down
+    t = hi.y - Pos.y;
+    if (t < min) { min = t; normal = Vector3(0,1,0);}; //up
+
+    // resume repere for the normal
+    if (cbox->selfrotated) normal = cbox->selfrot * normal;
+    if (cbox->refined) normal = cbox->rot * normal;
+    return normal;
+}
+
 int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
 {
     int new_tri_index = this->GetNumCollisionTris();
@@ -664,24 +999,27 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     new_tri.c=p3;
     new_tri.gm=gm;
     new_tri.enabled=true;
-    // compute transformations
-    // base construction
-    Vector3 bx=p2-p1;
-    Vector3 by=p3-p1;
-    Vector3 bz=bx.crossProduct(by);
-    bz.normalise();
-    // coordinates change matrix
-    new_tri.reverse.SetColumn(0, bx);
-    new_tri.reverse.SetColumn(1, by);
-    new_tri.reverse.SetColumn(2, bz);
-    new_tri.forward=new_tri.reverse.Inverse();
-
-    // compute tri AAB
-    new_tri.aab.merge(p1);
-    new_tri.aab.merge(p2);
-    new_tri.aab.merge(p3);
-    new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
-    new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
+    if (!this->replayCachedTri(new_tri))
+    {
+        // compute transformations
+        // base construction
+        Vector3 bx=p2-p1;
+        Vector3 by=p3-p1;
+        Vector3 bz=bx.crossProduct(by);
+        bz.normalise();
+        // coordinates change matrix
+        new_tri.reverse.SetColumn(0, bx);
+        new_tri.reverse.SetColumn(1, by);
+        new_tri.reverse.SetColumn(2, bz);
+        new_tri.forward=new_tri.reverse.Inverse();
+
+        // compute tri AAB
+        new_tri.aab.merge(p1);
+        new_tri.aab.merge(p2);
+        new_tri.aab.merge(p3);
+        new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
+        new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
+    }
     
     // register this collision tri in the index
     Ogre::Vector3 ilo(new_tri.aab.getMinimum() / Ogre::Real(CELL_SIZE));
@@ -772,6 +1110,26 @@ std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
                     return result;
                 }
             }
+            else if (hashtable[hash][k].IsCollisionMeshInstance())
+            {
+                const int inst_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_MESH_BASE_INDEX;
+                collision_mesh_instance_t *inst = &m_collision_mesh_instances[inst_index];
+
+                if (!inst->enabled)
+                    continue;
+
+                // transform the ray into mesh space; the ray parameter stays the same
+                Ray lray((inst->inv_orientation * (ray.getOrigin() - inst->position)) * inst->inv_scale,
+                         (inst->inv_orientation * ray.getDirection()) * inst->inv_scale);
+                for (const collision_tri_t& ltri: m_collision_meshes[inst->mesh_index].tris)
+                {
+                    auto result = Ogre::Math::intersects(lray, ltri.a, ltri.b, ltri.c);
+                    if (result.first && result.second < 1.0f)
+                    {
+                        return result;
+                    }
+                }
+            }
         }
     }
 
@@ -844,6 +1202,35 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
                 }
             }
         }
+        else if (hashtable[hash][k].IsCollisionMeshInstance())
+        {
+            const int inst_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_MESH_BASE_INDEX;
+            collision_mesh_instance_t *inst = &m_collision_mesh_instances[inst_index];
+
+            if (!inst->enabled)
+                continue;
+
+            auto lo = inst->aab.getMinimum();
+            auto hi = inst->aab.getMaximum();
+            if (surface_height >= hi.y)
+                continue;
+            if (x < lo.x || z < lo.z || x > hi.x || z > hi.z)
+                continue;
+
+            Ray lray((inst->inv_orientation * (origin - inst->position)) * inst->inv_scale, inst->inv_orientation * -Vector3::UNIT_Y);
+            for (const collision_tri_t& ltri: m_collision_meshes[inst->mesh_index].tris)
+            {
+                auto result = Ogre::Math::intersects(lray, ltri.a, ltri.b, ltri.c);
+                if (result.first)
+                {
+                    const float hit_y = origin.y - result.second * inst->scale;
+                    if (hit_y < height)
+                    {
+                        surface_height = std::max(surface_height, hit_y);
+                    }
+                }
+            }
+        }
         else // The element is a triangle
         {
             const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
@@ -883,7 +1270,8 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     if (refpos->y > hashtable_height[hash])
         return false;
 
-    collision_tri_t *minctri = 0;
+    const collision_tri_t *minctri = 0;
+    const collision_mesh_instance_t *minctri_inst = 0; // Set if 'minctri' is in mesh space
     float minctridist = 100.0f;
     Vector3 minctripoint;
 
@@ -973,6 +1361,21 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
                 }
             }
         }
+        else if (hashtable[hash][k].IsCollisionMeshInstance())
+        {
+            const int inst_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_MESH_BASE_INDEX;
+            const collision_mesh_instance_t *inst = &m_collision_mesh_instances[inst_index];
+            if (!inst->enabled)
+                continue;
+            if (!inst->aab.contains(*refpos))
+                continue;
+            const collision_tri_t *ltri = findMeshInstanceTri(*inst, *refpos, minctridist, minctripoint);
+            if (ltri)
+            {
+                minctri = ltri;
+                minctri_inst = inst;
+            }
+        }
         else // The element is a triangle
         {
             const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
@@ -990,6 +1393,7 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
                 if (-point.z < minctridist)
                 {
                     minctri = ctri;
+                    minctri_inst = 0;
                     minctridist = -point.z;
                     minctripoint = point;
                 }
@@ -1009,6 +1413,10 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
         minctripoint.z = 0;
         // reverse transform
         *refpos = (minctri->reverse * minctripoint) + minctri->a;
+        if (minctri_inst)
+        {
+            *refpos = (minctri_inst->orientation * (*refpos * minctri_inst->scale)) + minctri_inst->position;
+        }
     }
     return contacted;
 }
@@ -1047,87 +1455,27 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
     if (node->AbsPosition.y > hashtable_height[hash])
         return false;
 
-    collision_tri_t *minctri = 0;
-    float minctridist = 100.0;
-    Vector3 minctripoint;
-
-    bool contacted = false;
-    bool isScriptCallbackEnvoked = false;
+    const int box_bucket = hashtable_box_bucket[hash];
 
-    size_t num_elements = hashtable[hash].size();
-    for (size_t k=0; k < num_elements; k++)
+    if (envokeScriptCallbacks)
     {
-        if (hashtable[hash][k].cell_id != cell_id)
+        // Script event pass - only event-generating (and camera-forcing) boxes are of interest
+        bool isScriptCallbackEnvoked = false;
+        if (box_bucket != -1)
         {
-            continue;
-        }
-        else if (hashtable[hash][k].IsCollisionBox())
-        {
-            collision_box_t *cbox = &m_collision_boxes[hashtable[hash][k].element_index];
-
-            if (!cbox->enabled)
-                continue;
-
-            if (node->AbsPosition > cbox->lo && node->AbsPosition < cbox->hi)
+            for (const collision_box_pack_t& pack : m_box_buckets[box_bucket].event_packs)
             {
-                if (cbox->refined || cbox->selfrotated)
+                const int hits = testBoxPack(pack, node->AbsPosition, cell_id);
+                for (int lane = 0; hits != 0 && lane < pack.num_boxes; lane++)
                 {
-                    // we may have a collision, do a change of repere
-                    Vector3 Pos = node->AbsPosition-cbox->center;
-                    if (cbox->refined)
-                    {
-                        Pos = cbox->unrot * Pos;
-                    }
-                    if (cbox->selfrotated)
-                    {
-                        Pos = Pos - cbox->selfcenter;
-                        Pos = cbox->selfunrot * Pos;
-                        Pos = Pos + cbox->selfcenter;
-                    }
-                    // now test with the inner box
-                    if (Pos > cbox->relo && Pos < cbox->rehi)
-                    {
-                        if (cbox->eventsourcenum!=-1 && permitEvent(cbox->event_filter) && envokeScriptCallbacks)
-                        {
-                            envokeScriptCallback(cbox, node);
-                            isScriptCallbackEnvoked = true;
-                        }
-                        if (cbox->camforced && !forcecam)
-                        {
-                            forcecam = true;
-                            forcecampos = cbox->campos;
-                        }
-                        if (!cbox->virt && !envokeScriptCallbacks)
-                        {
-                            // collision, process as usual
-                            // we have a collision
-                            contacted = true;
-                            // determine which side collided
-                            float t = cbox->rehi.z - Pos.z;
-                            float min = Pos.z - cbox->relo.z;
-                            Vector3 normal = Vector3(0, 0, -1);
-                            if (t < min) { min = t; normal = Vector3(0,0,1);}; //north
-                            t = Pos.x - cbox->relo.x;
-                            if (t < min) { min = t; normal = Vector3(-1,0,0);}; //west
-                            t = cbox->rehi.x - Pos.x;
-                            if (t < min) { min = t; normal = Vector3(1,0,0);}; //east
-                            t = Pos.y - cbox->relo.y;
-                            if (t < min) { min = t; normal = Vector3(0,-1,0);}; //down
-                            t = cbox->rehi.y - Pos.y;
-                            if (t < min) { min = t; normal = Vector3(0,1,0);}; //up
-
-                            // resume repere for the normal
-                            if (cbox->selfrotated) normal = cbox->selfrot * normal;
-                            if (cbox->refined) normal = cbox->rot * normal;
-
-                            // collision boxes are always out of concrete as it seems
-                            node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, defaultgm);
-                            node->nd_last_collision_gm = defaultgm;
-                        }
-                    }
-                } else
-                {
-                    if (cbox->eventsourcenum!=-1 && permitEvent(cbox->event_filter) && envokeScriptCallbacks)
+                    if (!(hits & (1 << lane)))
+                        continue;
+
+                    collision_box_t *cbox = &m_collision_boxes[pack.box_index[lane]];
+                    if (!cbox->enabled)
+                        continue;
+
+                    if (cbox->eventsourcenum!=-1 && permitEvent(cbox->event_filter))
                     {
                         envokeScriptCallback(cbox, node);
                         isScriptCallbackEnvoked = true;
@@ -1137,35 +1485,77 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
                         forcecam = true;
                         forcecampos = cbox->campos;
                     }
-                    if (!cbox->virt && !envokeScriptCallbacks)
-                    {
-                        // we have a collision
-                        contacted=true;
-                        // determine which side collided
-                        float t = cbox->hi.z - node->AbsPosition.z;
-                        float min = node->AbsPosition.z - cbox->lo.z;
-                        Vector3 normal = Vector3(0, 0, -1);
-                        if (t < min) {min = t; normal = Vector3(0,0,1);}; //north
-                        t = node->AbsPosition.x - cbox->lo.x;
-                        if (t < min) {min = t; normal = Vector3(-1,0,0);}; //west
-                        t = cbox->hi.x - node->AbsPosition.x;
-                        if (t < min) {min = t; normal = Vector3(1,0,0);}; //east
-                        t = node->AbsPosition.y - cbox->lo.y;
-                        if (t < min) {min = t; normal = Vector3(0,-1,0);}; //down
-                        t = cbox->hi.y - node->AbsPosition.y;
-                        if (t < min) {min = t; normal = Vector3(0,1,0);}; //up
-
-                        // resume repere for the normal
-                        if (cbox->selfrotated) normal = cbox->selfrot * normal;
-                        if (cbox->refined) normal = cbox->rot * normal;
-
-                        // collision boxes are always out of concrete as it seems
-                        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, defaultgm);
-                        node->nd_last_collision_gm = defaultgm;
-                    }
                 }
             }
         }
+        if (!isScriptCallbackEnvoked)
+            clearEventCache();
+        return false;
+    }
+
+    const collision_tri_t *minctri = 0;
+    const collision_mesh_instance_t *minctri_inst = 0; // Set if 'minctri' is in mesh space
+    float minctridist = 100.0;
+    Vector3 minctripoint;
+
+    bool contacted = false;
+
+    if (box_bucket != -1)
+    {
+        for (const collision_box_pack_t& pack : m_box_buckets[box_bucket].solid_packs)
+        {
+            const int hits = testBoxPack(pack, node->AbsPosition, cell_id);
+            for (int lane = 0; hits != 0 && lane < pack.num_boxes; lane++)
+            {
+                if (!(hits & (1 << lane)))
+                    continue;
+
+                collision_box_t *cbox = &m_collision_boxes[pack.box_index[lane]];
+                if (!cbox->enabled)
+                    continue;
+
+                if (cbox->camforced && !forcecam)
+                {
+                    forcecam = true;
+                    forcecampos = cbox->campos;
+                }
+                if (!cbox->virt)
+                {
+                    // we have a collision
+                    contacted = true;
+                    Vector3 normal = calcBoxCollisionNormal(cbox, node->AbsPosition);
+
+                    // collision boxes are always out of concrete as it seems
+                    node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, defaultgm);
+                    node->nd_last_collision_gm = defaultgm;
+                }
+            }
+        }
+    }
+
+    size_t num_elements = hashtable[hash].size();
+    for (size_t k=0; k < num_elements; k++)
+    {
+        if (hashtable[hash][k].cell_id != cell_id || hashtable[hash][k].IsCollisionBox())
+        {
+            continue; // Boxes are tested above, see 'm_box_buckets'
+        }
+        else if (hashtable[hash][k].IsCollisionMeshInstance())
+        {
+            // instanced mesh collision
+            const int inst_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_MESH_BASE_INDEX;
+            const collision_mesh_instance_t *inst = &m_collision_mesh_instances[inst_index];
+            if (!inst->enabled)
+                continue;
+            if (!inst->aab.contains(node->AbsPosition))
+                continue;
+            const collision_tri_t *ltri = findMeshInstanceTri(*inst, node->AbsPosition, minctridist, minctripoint);
+            if (ltri)
+            {
+                minctri = ltri;
+                minctri_inst = inst;
+            }
+        }
         else
         {
             // tri collision
@@ -1186,6 +1576,7 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
                 if (-point.z < minctridist)
                 {
                     minctri = ctri;
+                    minctri_inst = 0;
                     minctridist = -point.z;
                     minctripoint = point;
                 }
@@ -1193,19 +1584,22 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
         }
     }
 
-    if (envokeScriptCallbacks && !isScriptCallbackEnvoked)
-        clearEventCache();
-
     // process minctri collision
-    if (minctri && !envokeScriptCallbacks)
+    if (minctri)
     {
         // we have a contact
         contacted=true;
         // we need the normal
         // resume repere for the normal
         Vector3 normal = minctri->reverse * Vector3::UNIT_Z;
-        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, minctri->gm);
-        node->nd_last_collision_gm = minctri->gm;
+        ground_model_t* gm = minctri->gm;
+        if (minctri_inst)
+        {
+            normal = minctri_inst->orientation * normal;
+            gm = minctri_inst->gm;
+        }
+        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, gm);
+        node->nd_last_collision_gm = gm;
     }
 
     return contacted;
@@ -1293,13 +1687,13 @@ bool Collisions::isInside(Vector3 pos, collision_box_t *cbox, float border)
 
 bool Collisions::groundCollision(node_t *node, float dt)
 {
-    Real v = App::GetSimTerrain()->GetHeightAt(node->AbsPosition.x, node->AbsPosition.z);
+    Ogre::Vector3 normal;
+    Real v = App::GetSimTerrain()->GetHeightAndNormalAt(node->AbsPosition.x, node->AbsPosition.z, normal);
     if (v > node->AbsPosition.y)
     {
         ground_model_t* ogm = landuse ? landuse->getGroundModelAt(node->AbsPosition.x, node->AbsPosition.z) : nullptr;
         // when landuse fails or we don't have it, use the default value
         if (!ogm) ogm = defaultgroundgm;
-        Ogre::Vector3 normal = App::GetSimTerrain()->GetNormalAt(node->AbsPosition.x, v, node->AbsPosition.z);
         node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, ogm, v - node->AbsPosition.y);
         node->nd_last_collision_gm = ogm;
         return true;
@@ -1516,46 +1910,45 @@ int Collisions::createCollisionDebugVisualization()
     return 0;
 }
 
-int Collisions::addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t *gm, std::vector<int> *collTris)
+int Collisions::addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t *gm, std::vector<int> *collTris, std::vector<int> *collMeshInstances)
 {
-    // normal, non virtual collision box
-    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
-    ent->setMaterialName("tracks/debug/collision/mesh");
-
     if (!gm)
     {
         gm = getGroundModelByString("concrete");
     }
 
-    size_t vertex_count,index_count;
-    Vector3* vertices;
-    unsigned* indices;
-
-    getMeshInformation(ent->getMesh().getPointer(),vertex_count,vertices,index_count,indices, pos, q, scale);
+    const int mesh_index = this->loadCollisionMesh(meshname);
+    const collision_mesh_t& mesh = m_collision_meshes[mesh_index];
 
-    //LOG(LML_NORMAL,"Vertices in mesh: %u",vertex_count);
-    //LOG(LML_NORMAL,"Triangles in mesh: %u",index_count / 3);
-    for (int i=0; i<(int)index_count/3; i++)
+    const bool uniform_scale = Math::RealEqual(scale.x, scale.y, 0.0001f) && Math::RealEqual(scale.x, scale.z, 0.0001f) && scale.x > 0.f;
+    const bool can_instance = (collTris == nullptr || collMeshInstances != nullptr);
+    if (uniform_scale && can_instance && !mesh.tris.empty() && mesh.tris.size() <= MAX_INSTANCED_MESH_TRIS)
     {
-        int triID = addCollisionTri(vertices[indices[i*3]], vertices[indices[i*3+1]], vertices[indices[i*3+2]], gm);
-        if (collTris)
-            collTris->push_back(triID);
+        int instance_id = addCollisionMeshInstance(mesh_index, pos, q, scale.x, gm);
+        if (collMeshInstances)
+            collMeshInstances->push_back(instance_id);
     }
-
-    delete[] vertices;
-    delete[] indices;
-    if (!debugMode)
+    else
     {
-        App::GetGfxScene()->GetSceneManager()->destroyEntity(ent);
-    } else
+        for (const collision_tri_t& ltri: mesh.tris)
+        {
+            int triID = addCollisionTri((q * (ltri.a * scale)) + pos, (q * (ltri.b * scale)) + pos, (q * (ltri.c * scale)) + pos, gm);
+            if (collTris)
+                collTris->push_back(triID);
+        }
+    }
+
+    if (debugMode)
     {
+        Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
+        ent->setMaterialName("tracks/debug/collision/mesh");
         SceneNode *n=App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
         n->attachObject(ent);
         n->setPosition(pos);
         n->setScale(scale);
         n->setOrientation(q);
     
-        String labelName = "collision_mesh_label_"+TOSTRING(this->GetNumCollisionTris());
+        String labelName = "collision_mesh_label_"+TOSTRING(this->GetNumCollisionTris())+"_"+TOSTRING(m_collision_mesh_instances.size());
         String labelCaption = "COLLMESH\nmeshname:"+meshname + "\ngroundmodel:" + String(gm->name);
         MovableText *mt = new MovableText(labelName, labelCaption);
         mt->setTextAlignment(MovableText::H_CENTER, MovableText::V_ABOVE);
@@ -1570,6 +1963,233 @@ int Collisions::addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre:
     return 0;
 }
 
+int Collisions::loadCollisionMesh(const Ogre::String& meshname)
+{
+    auto found = m_collision_mesh_lookup.find(meshname);
+    if (found != m_collision_mesh_lookup.end())
+    {
+        return found->second;
+    }
+
+    collision_mesh_t cmesh;
+    cmesh.mesh_name = meshname;
+    GetCollisionMeshFingerprint(meshname, cmesh.source_size, cmesh.source_time);
+
+    if (!this->loadCachedCollisionMesh(cmesh))
+    {
+        m_cache_dirty = true;
+
+        MeshPtr mesh = MeshManager::getSingleton().load(meshname, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+
+        size_t vertex_count,index_count;
+        Vector3* vertices;
+        unsigned* indices;
+
+        getMeshInformation(mesh.getPointer(),vertex_count,vertices,index_count,indices);
+        TriangulateCollisionMesh(cmesh, vertices, index_count, indices);
+
+        delete[] vertices;
+        delete[] indices;
+    }
+
+    return this->registerCollisionMesh(cmesh);
+}
+
+bool Collisions::loadCachedCollisionMesh(collision_mesh_t& cmesh)
+{
+    auto cached = m_cache_meshes.find(cmesh.mesh_name);
+    if (cached == m_cache_meshes.end())
+    {
+        return false;
+    }
+
+    // Record was bounds-checked in `loadCollisionCache()`
+    const char* record = cached->second;
+    uint64_t source_size;
+    int64_t source_time;
+    uint32_t num_tris;
+    std::memcpy(&source_size, record, sizeof(uint64_t));
+    std::memcpy(&source_time, record + sizeof(uint64_t), sizeof(int64_t));
+    std::memcpy(&num_tris, record + sizeof(uint64_t) + sizeof(int64_t), sizeof(uint32_t));
+    if (cmesh.source_size == 0 || source_size != cmesh.source_size || source_time != cmesh.source_time)
+    {
+        LOG("COLL: Cached collision mesh '" + cmesh.mesh_name + "' is outdated");
+        return false;
+    }
+
+    const collision_cache_tri_t* records = reinterpret_cast<const collision_cache_tri_t*>(record + sizeof(uint64_t) + sizeof(int64_t) + sizeof(uint32_t));
+    cmesh.tris.resize(num_tris);
+    for (uint32_t i = 0; i < num_tris; i++)
+    {
+        collision_tri_t& ltri = cmesh.tris[i];
+        ltri.a = CacheReadVector3(records[i].a);
+        ltri.b = CacheReadVector3(records[i].b);
+        ltri.c = CacheReadVector3(records[i].c);
+        ltri.forward = CacheReadMatrix3(records[i].forward);
+        ltri.reverse = CacheReadMatrix3(records[i].reverse);
+        ltri.gm = nullptr;
+        ltri.enabled = true;
+        cmesh.aab.merge(ltri.a);
+        cmesh.aab.merge(ltri.b);
+        cmesh.aab.merge(ltri.c);
+    }
+    return true;
+}
+
+int Collisions::registerCollisionMesh(collision_mesh_t& cmesh)
+{
+    const int mesh_index = static_cast<int>(m_collision_meshes.size());
+    m_collision_mesh_lookup.insert(std::make_pair(cmesh.mesh_name, mesh_index));
+    m_collision_meshes.push_back(std::move(cmesh));
+    return mesh_index;
+}
+
+void Collisions::prepareCollisionMeshes(std::vector<Ogre::String> const& meshnames)
+{
+    struct MeshLoad
+    {
+        collision_mesh_t cmesh;
+        size_t           vertex_count = 0;
+        size_t           index_count = 0;
+        Vector3*         vertices = nullptr;
+        unsigned*        indices = nullptr;
+    };
+
+    // Fetch the geometry on main thread - Ogre resource system isn't thread-safe.
+    std::vector<MeshLoad> loads;
+    loads.reserve(meshnames.size());
+    for (const Ogre::String& meshname: meshnames)
+    {
+        if (m_collision_mesh_lookup.find(meshname) != m_collision_mesh_lookup.end())
+        {
+            continue;
+        }
+        MeshLoad load;
+        load.cmesh.mesh_name = meshname;
+        GetCollisionMeshFingerprint(meshname, load.cmesh.source_size, load.cmesh.source_time);
+        if (this->loadCachedCollisionMesh(load.cmesh))
+        {
+            this->registerCollisionMesh(load.cmesh); // Nothing to triangulate
+            continue;
+        }
+
+        try
+        {
+            MeshPtr mesh = MeshManager::getSingleton().load(meshname, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            getMeshInformation(mesh.getPointer(), load.vertex_count, load.vertices, load.index_count, load.indices);
+            loads.push_back(load);
+        }
+        catch (Ogre::Exception& e)
+        {
+            // Leave it to `addCollisionMesh()` to report the error as usual.
+            LOG("[RoR|Collisions] Cannot preload collision mesh '" + meshname + "': " + e.getDescription());
+        }
+    }
+
+    // Triangulate on worker threads
+    std::vector<std::function<void()>> tasks;
+    for (MeshLoad& load: loads)
+    {
+        MeshLoad* load_ptr = &load;
+        tasks.push_back([load_ptr]()
+            {
+                TriangulateCollisionMesh(load_ptr->cmesh, load_ptr->vertices, load_ptr->index_count, load_ptr->indices);
+            });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    // Register
+    for (MeshLoad& load: loads)
+    {
+        delete[] load.vertices;
+        delete[] load.indices;
+
+        m_cache_dirty = true;
+        this->registerCollisionMesh(load.cmesh);
+    }
+}
+
+int Collisions::addCollisionMeshInstance(int mesh_index, Vector3 pos, Quaternion q, float scale, ground_model_t* gm)
+{
+    const collision_mesh_t& mesh = m_collision_meshes[mesh_index];
+    const int new_inst_index = static_cast<int>(m_collision_mesh_instances.size());
+
+    collision_mesh_instance_t inst;
+    inst.mesh_index = mesh_index;
+    inst.position = pos;
+    inst.orientation = q;
+    inst.inv_orientation = q.Inverse();
+    inst.scale = scale;
+    inst.inv_scale = 1.f / scale;
+    inst.gm = gm;
+    inst.enabled = true;
+
+    // compute world AAB
+    Matrix4 transform;
+    transform.makeTransform(pos, Vector3(scale), q);
+    inst.aab = mesh.aab;
+    inst.aab.transformAffine(transform);
+    inst.aab.setMinimum(inst.aab.getMinimum() - 0.1f);
+    inst.aab.setMaximum(inst.aab.getMaximum() + 0.1f);
+
+    // register this instance in the index
+    Ogre::Vector3 ilo(inst.aab.getMinimum() / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ihi(inst.aab.getMaximum() / Ogre::Real(CELL_SIZE));
+
+    // clamp between 0 and MAXIMUM_CELL;
+    ilo.makeCeil(Ogre::Vector3(0.0f));
+    ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+    ihi.makeCeil(Ogre::Vector3(0.0f));
+    ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+
+    for (int i = ilo.x; i <= ihi.x; i++)
+    {
+        for (int j = ilo.z; j<=ihi.z; j++)
+        {
+            hash_add(i, j, new_inst_index + hash_coll_element_t::ELEMENT_MESH_BASE_INDEX, inst.aab.getMaximum().y);
+        }
+    }
+
+    if (debugMode)
+    {
+        for (const collision_tri_t& ltri: mesh.tris)
+        {
+            debugmo->position((q * (ltri.a * scale)) + pos);
+            debugmo->position((q * (ltri.b * scale)) + pos);
+            debugmo->position((q * (ltri.c * scale)) + pos);
+        }
+    }
+
+    m_collision_aab.merge(inst.aab);
+    m_collision_mesh_instances.push_back(inst);
+    return new_inst_index;
+}
+
+const Collisions::collision_tri_t* Collisions::findMeshInstanceTri(const collision_mesh_instance_t& inst, const Vector3& pos, float& mindist, Vector3& point)
+{
+    const collision_tri_t* result = nullptr;
+    const collision_mesh_t& mesh = m_collision_meshes[inst.mesh_index];
+    const Vector3 local_pos = (inst.inv_orientation * (pos - inst.position)) * inst.inv_scale;
+    const float max_depth = 0.1f * inst.inv_scale; // The collision volume is 10cm deep in world space
+
+    for (const collision_tri_t& ltri: mesh.tris)
+    {
+        // transform
+        Vector3 lpoint = ltri.forward * (local_pos - ltri.a);
+        // test if within tri collision volume
+        if (lpoint.x >= 0 && lpoint.y >= 0 && (lpoint.x + lpoint.y) <= 1.0 && lpoint.z < 0 && lpoint.z > -max_depth)
+        {
+            if (-lpoint.z * inst.scale < mindist)
+            {
+                result = &ltri;
+                mindist = -lpoint.z * inst.scale;
+                point = lpoint;
+            }
+        }
+    }
+    return result;
+}
+
 void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Vector3* &vertices,
                                               size_t &index_count, unsigned* &indices,
                                               const Vector3 &position,
@@ -1689,6 +2309,17 @@ void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Vector3* &ve
 
 void Collisions::finishLoadingTerrain()
 {
+    // Fewer tris than cached means the terrain changed, too
+    if (m_cache_tris != nullptr && m_cache_replay_pos != m_cache_num_tris)
+    {
+        m_cache_dirty = true;
+    }
+    this->closeCollisionCache(); // Everything needed was copied out; must be unmapped before rewriting on Windows
+    if (!m_cache_filename.empty() && m_cache_dirty)
+    {
+        this->saveCollisionCache();
+    }
+
     if (debugMode)
     {
         SceneNode *debugsn = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
@@ -1699,3 +2330,213 @@ void Collisions::finishLoadingTerrain()
         createCollisionDebugVisualization();
     }
 }
+
+void Collisions::setupCollisionCache(CacheEntry const& terrn_entry)
+{
+    uint64_t source_size = 0;
+    std::time_t source_time = 0;
+    if (!RoR::GetFileSizeAndTime(CacheSystem::GetFingerprintPath(terrn_entry), source_size, source_time))
+    {
+        return; // Cache disabled
+    }
+
+    const std::string key = terrn_entry.resource_bundle_path + "|" + terrn_entry.fname;
+    const std::string key_hash = HashData(key.c_str(), static_cast<int>(key.size()));
+    m_cache_filename = "collisions_" + key_hash + ".dat";
+    m_landuse_cache_filename = "landuse_" + key_hash + ".dat";
+    m_cache_source_size = source_size;
+    m_cache_source_time = static_cast<int64_t>(source_time);
+
+    if (!this->loadCollisionCache())
+    {
+        this->closeCollisionCache();
+        m_cache_dirty = true;
+    }
+}
+
+bool Collisions::loadCollisionCache()
+{
+    m_cache_mapping = std::make_shared<MappedFile>();
+    if (!m_cache_mapping->Open(PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename)))
+    {
+        return false;
+    }
+
+    CollisionCacheReader reader;
+    reader.pos = m_cache_mapping->GetData();
+    reader.end = m_cache_mapping->GetData() + m_cache_mapping->GetSize();
+
+    CollisionCacheHeader header;
+    const char* header_ptr = reader.Map(sizeof(CollisionCacheHeader));
+    if (!header_ptr)
+    {
+        return false;
+    }
+    std::memcpy(&header, header_ptr, sizeof(CollisionCacheHeader));
+    if (strncmp(header.signature, COLLISION_CACHE_SIGNATURE, COLLISION_CACHE_SIGNATURE_LENGTH) != 0 ||
+        header.file_format_version != COLLISION_CACHE_FORMAT_VERSION ||
+        header.source_size != m_cache_source_size || header.source_time != m_cache_source_time)
+    {
+        LOG("COLL: Collision cache '" + m_cache_filename + "' is outdated");
+        return false;
+    }
+
+    m_cache_gm_names.resize(header.num_gm_names);
+    for (std::string& gm_name: m_cache_gm_names)
+    {
+        if (!reader.ReadString(gm_name))
+            return false;
+    }
+
+    for (uint32_t i = 0; i < header.num_meshes; i++)
+    {
+        std::string mesh_name;
+        if (!reader.ReadString(mesh_name))
+            return false;
+        const char* record = reader.Map(sizeof(uint64_t) + sizeof(int64_t) + sizeof(uint32_t)); // Fingerprint, tri count
+        if (!record)
+            return false;
+        uint32_t num_tris;
+        std::memcpy(&num_tris, record + sizeof(uint64_t) + sizeof(int64_t), sizeof(uint32_t));
+        if (!reader.Map(sizeof(collision_cache_tri_t) * num_tris))
+            return false;
+        m_cache_meshes[mesh_name] = record;
+    }
+
+    const char* tris = reader.Map(sizeof(collision_cache_tri_t) * header.num_tris);
+    if (!tris)
+        return false;
+    m_cache_tris = reinterpret_cast<const collision_cache_tri_t*>(tris);
+    m_cache_num_tris = header.num_tris;
+    m_cache_replay_pos = 0;
+
+    LOG("COLL: Using collision cache '" + m_cache_filename + "'");
+    return true;
+}
+
+bool Collisions::replayCachedTri(collision_tri_t& tri)
+{
+    if (m_cache_tris == nullptr)
+    {
+        return false;
+    }
+    if (m_cache_replay_pos >= m_cache_num_tris)
+    {
+        m_cache_dirty = true;
+        return false;
+    }
+
+    const collision_cache_tri_t& rec = m_cache_tris[m_cache_replay_pos];
+    const bool gm_matches = (rec.gm_index < 0)
+        ? (tri.gm == nullptr)
+        : (tri.gm != nullptr && rec.gm_index < (int)m_cache_gm_names.size() && m_cache_gm_names[rec.gm_index] == tri.gm->name);
+    if (!gm_matches || CacheReadVector3(rec.a) != tri.a || CacheReadVector3(rec.b) != tri.b || CacheReadVector3(rec.c) != tri.c)
+    {
+        // The terrain was modified (or a script spawned different objects) - compute everything from here on.
+        LOG("COLL: Collision cache mismatch at tri " + TOSTRING(m_cache_replay_pos) + ", it will be rebuilt");
+        m_cache_tris = nullptr;
+        m_cache_dirty = true;
+        return false;
+    }
+
+    tri.forward = CacheReadMatrix3(rec.forward);
+    tri.reverse = CacheReadMatrix3(rec.reverse);
+    tri.aab.setExtents(CacheReadVector3(rec.aab_min), CacheReadVector3(rec.aab_max));
+    m_cache_replay_pos++;
+    return true;
+}
+
+void Collisions::saveCollisionCache()
+{
+    // Ground model names
+    std::map<std::string, int32_t> gm_lookup;
+    std::vector<std::string> gm_names;
+    for (const collision_tri_t& tri: m_collision_tris)
+    {
+        if (tri.gm != nullptr && gm_lookup.find(tri.gm->name) == gm_lookup.end())
+        {
+            gm_lookup[tri.gm->name] = static_cast<int32_t>(gm_names.size());
+            gm_names.push_back(tri.gm->name);
+        }
+    }
+
+    CollisionCacheHeader header;
+    std::memset(&header, 0, sizeof(CollisionCacheHeader));
+    strncpy(header.signature, COLLISION_CACHE_SIGNATURE, COLLISION_CACHE_SIGNATURE_LENGTH - 1);
+    header.file_format_version = COLLISION_CACHE_FORMAT_VERSION;
+    header.num_gm_names = static_cast<uint32_t>(gm_names.size());
+    header.num_meshes = static_cast<uint32_t>(m_collision_meshes.size());
+    header.num_tris = static_cast<uint32_t>(m_collision_tris.size());
+    header.source_size = m_cache_source_size;
+    header.source_time = m_cache_source_time;
+
+    std::vector<char> buf;
+    buf.reserve(sizeof(CollisionCacheHeader) + sizeof(collision_cache_tri_t) * m_collision_tris.size());
+    CacheAppend(buf, &header, sizeof(CollisionCacheHeader));
+    for (std::string const& gm_name: gm_names)
+    {
+        CacheAppendString(buf, gm_name);
+    }
+
+    collision_cache_tri_t rec;
+    std::memset(&rec, 0, sizeof(collision_cache_tri_t));
+    for (const collision_mesh_t& cmesh: m_collision_meshes)
+    {
+        CacheAppendString(buf, cmesh.mesh_name);
+        CacheAppend(buf, &cmesh.source_size, sizeof(uint64_t));
+        CacheAppend(buf, &cmesh.source_time, sizeof(int64_t));
+        const uint32_t num_tris = static_cast<uint32_t>(cmesh.tris.size());
+        CacheAppend(buf, &num_tris, sizeof(uint32_t));
+        for (const collision_tri_t& ltri: cmesh.tris)
+        {
+            CacheWriteVector3(rec.a, ltri.a);
+            CacheWriteVector3(rec.b, ltri.b);
+            CacheWriteVector3(rec.c, ltri.c);
+            CacheWriteMatrix3(rec.forward, ltri.forward);
+            CacheWriteMatrix3(rec.reverse, ltri.reverse);
+            rec.gm_index = -1;
+            CacheAppend(buf, &rec, sizeof(collision_cache_tri_t));
+        }
+    }
+
+    for (const collision_tri_t& tri: m_collision_tris)
+    {
+        CacheWriteVector3(rec.a, tri.a);
+        CacheWriteVector3(rec.b, tri.b);
+        CacheWriteVector3(rec.c, tri.c);
+        CacheWriteVector3(rec.aab_min, tri.aab.getMinimum());
+        CacheWriteVector3(rec.aab_max, tri.aab.getMaximum());
+        CacheWriteMatrix3(rec.forward, tri.forward);
+        CacheWriteMatrix3(rec.reverse, tri.reverse);
+        rec.gm_index = (tri.gm != nullptr) ? gm_lookup[tri.gm->name] : -1;
+        CacheAppend(buf, &rec, sizeof(collision_cache_tri_t));
+    }
+
+    // Write to a temporary file and swap it in when complete
+    const std::string path = PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename);
+    FILE* file = fopen((path + ".tmp").c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+    const bool written = (fwrite(buf.data(), 1, buf.size(), file) == buf.size());
+    fclose(file);
+    std::remove(path.c_str());
+    if (!written || std::rename((path + ".tmp").c_str(), path.c_str()) != 0)
+    {
+        std::remove((path + ".tmp").c_str());
+        LOG("COLL: Failed to write collision cache '" + m_cache_filename + "'");
+        return;
+    }
+    LOG("COLL: Saved collision cache '" + m_cache_filename + "' (" + TOSTRING(m_collision_meshes.size()) + " meshes, " + TOSTRING(m_collision_tris.size()) + " tris)");
+}
+
+void Collisions::closeCollisionCache()
+{
+    m_cache_tris = nullptr;
+    m_cache_num_tris = 0;
+    m_cache_replay_pos = 0;
+    m_cache_meshes.clear();
+    m_cache_gm_names.clear();
+    m_cache_mapping.reset();
+}
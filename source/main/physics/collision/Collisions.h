@@ -25,11 +25,15 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <Ogre.h>
 
 namespace RoR {
 
+class MappedFile;
+
 struct eventsource_t
 {
     char instancename[256];
@@ -66,16 +70,19 @@ private:
     struct hash_coll_element_t
     {
         static const int ELEMENT_TRI_BASE_INDEX = 1000000; // Effectively a maximum number of collision boxes
+        static const int ELEMENT_MESH_BASE_INDEX = 1000000000; // Effectively a maximum number of collision tris
 
         inline hash_coll_element_t(unsigned int cell_id_, int value): cell_id(cell_id_), element_index(value) {}
 
         inline bool IsCollisionBox() const { return element_index < ELEMENT_TRI_BASE_INDEX; }
-        inline bool IsCollisionTri() const { return element_index >= ELEMENT_TRI_BASE_INDEX; }
+        inline bool IsCollisionTri() const { return element_index >= ELEMENT_TRI_BASE_INDEX && element_index < ELEMENT_MESH_BASE_INDEX; }
+        inline bool IsCollisionMeshInstance() const { return element_index >= ELEMENT_MESH_BASE_INDEX; }
 
         unsigned int cell_id;
 
         /// Values below ELEMENT_TRI_BASE_INDEX are collision box indices (Collisions::m_collision_boxes),
-        ///    values above are collision tri indices (Collisions::m_collision_tris).
+        ///    values above are collision tri indices (Collisions::m_collision_tris),
+        ///    values above ELEMENT_MESH_BASE_INDEX are collision mesh instance indices (Collisions::m_collision_mesh_instances).
         int element_index;
     };
 
@@ -91,6 +98,71 @@ private:
         bool enabled;
     };
 
+    /// Triangles of one mesh file in mesh space, loaded once and shared by all placements of the mesh.
+    struct collision_mesh_t
+    {
+        Ogre::String mesh_name;
+        std::vector<collision_tri_t> tris; // `aab`, `gm` and `enabled` are unused
+        Ogre::AxisAlignedBox aab;
+        uint64_t source_size = 0; // Fingerprint of the mesh's source ZIP/file, for the collision cache
+        int64_t source_time = 0;  // Fingerprint of the mesh's source ZIP/file, for the collision cache
+    };
+
+    /// Placement of a `collision_mesh_t`; node queries are transformed into mesh space.
+    /// Only uniform scale is supported, see `addCollisionMesh()`.
+    struct collision_mesh_instance_t
+    {
+        int mesh_index;
+        Ogre::Vector3 position;
+        Ogre::Quaternion orientation;
+        Ogre::Quaternion inv_orientation;
+        float scale;
+        float inv_scale;
+        Ogre::AxisAlignedBox aab; // World space
+        ground_model_t* gm;
+        bool enabled;
+    };
+
+    /// Up to 4 collision boxes in SoA layout, tested against a point at once by `testBoxPack()`.
+    /// Each box is an OBB: the point is inside if |rot * (point - center)| < half_extent on all axes.
+    /// Unused lanes have negative half extents, so they never hit.
+    struct collision_box_pack_t
+    {
+        static const int NUM_LANES = 4;
+
+        float center_x[NUM_LANES]; // World space; `collision_box_t::center` + self-rotation center
+        float center_y[NUM_LANES];
+        float center_z[NUM_LANES];
+        float half_x[NUM_LANES];
+        float half_y[NUM_LANES];
+        float half_z[NUM_LANES];
+        float rot[9][NUM_LANES];   // World->box rotation (`selfunrot * unrot`), rows
+        uint32_t cell_id[NUM_LANES];
+        int box_index[NUM_LANES];  // Index to `m_collision_boxes`
+        int num_boxes;
+    };
+
+    /// Box packs of one hashtable entry. Event-generating boxes are kept apart, so the physics
+    /// pass of `nodeCollision()` never walks them; camera-forcing boxes are in both lists.
+    struct collision_box_bucket_t
+    {
+        std::vector<collision_box_pack_t> solid_packs;
+        std::vector<collision_box_pack_t> event_packs;
+    };
+
+    /// Collision cache record (file layout, 4-byte aligned); stores a tri with its precomputed transformations.
+    struct collision_cache_tri_t
+    {
+        float a[3];
+        float b[3];
+        float c[3];
+        float aab_min[3];
+        float aab_max[3];
+        float forward[9];
+        float reverse[9];
+        int32_t gm_index; // Index to ground model name table, -1 = none
+    };
+
     static const int LATEST_GROUND_MODEL_VERSION = 3;
     static const int MAX_EVENT_SOURCE = 500;
 
@@ -98,6 +170,9 @@ private:
     static const int HASH_POWER = 20;
     static const int HASH_SIZE = 1 << HASH_POWER;
 
+    // meshes with more tris are registered tri-by-tri, they'd be too slow to test as a whole
+    static const int MAX_INSTANCED_MESH_TRIS = 128;
+
     // how many elements per cell? power of 2 minus 2 is better
     static const int CELL_BLOCKSIZE = 126;
 
@@ -112,11 +187,31 @@ private:
     // collision tris pool;
     std::vector<collision_tri_t> m_collision_tris; // Formerly MAX_COLLISION_TRIS = 100000
 
+    // collision meshes (mesh space) and their placements
+    std::vector<collision_mesh_t> m_collision_meshes;
+    std::map<Ogre::String, int> m_collision_mesh_lookup; // mesh name -> index to m_collision_meshes
+    std::vector<collision_mesh_instance_t> m_collision_mesh_instances;
+
+    // collision cache, see `setupCollisionCache()`
+    std::string m_cache_filename; // Empty = cache disabled
+    std::string m_landuse_cache_filename; // Empty = cache disabled; see `setupLandUse()`
+    uint64_t m_cache_source_size = 0;
+    int64_t m_cache_source_time = 0;
+    std::shared_ptr<MappedFile> m_cache_mapping;
+    std::vector<std::string> m_cache_gm_names;
+    std::map<Ogre::String, const char*> m_cache_meshes; // mesh name -> record in the mapping; see `loadCachedCollisionMesh()`
+    const collision_cache_tri_t* m_cache_tris = nullptr; // world-space tris, in `addCollisionTri()` call order
+    size_t m_cache_num_tris = 0;
+    size_t m_cache_replay_pos = 0;
+    bool m_cache_dirty = false; // Cache must be (re)written in `finishLoadingTerrain()`
+
     Ogre::AxisAlignedBox m_collision_aab; // Tight bounding box around all collision meshes
 
     // collision hashtable
     Ogre::Real hashtable_height[HASH_SIZE];
     std::vector<hash_coll_element_t> hashtable[HASH_SIZE];
+    int hashtable_box_bucket[HASH_SIZE]; // Index to 'm_box_buckets', -1 = no boxes
+    std::vector<collision_box_bucket_t> m_box_buckets;
 
     // ground models
     std::map<Ogre::String, ground_model_t> ground_models;
@@ -145,6 +240,24 @@ private:
 
     Ogre::Vector3 calcCollidedSide(const Ogre::Vector3& pos, const Ogre::Vector3& lo, const Ogre::Vector3& hi);
 
+    void addBoxToPacks(int cell_x, int cell_z, int box_index);
+    static void addBoxToPack(std::vector<collision_box_pack_t>& packs, unsigned int cell_id, int box_index, const collision_box_t& cbox);
+    /// Returns a bitmask of lanes whose box contains the point and belongs to the cell.
+    static int testBoxPack(const collision_box_pack_t& pack, const Ogre::Vector3& pos, unsigned int cell_id);
+    Ogre::Vector3 calcBoxCollisionNormal(const collision_box_t* cbox, const Ogre::Vector3& pos);
+
+    bool loadCollisionCache();
+    void saveCollisionCache();
+    void closeCollisionCache();
+    bool replayCachedTri(collision_tri_t& tri); /// Fills precomputed data if 'tri' matches the next cached one
+
+    int loadCollisionMesh(const Ogre::String& meshname); /// Returns index to 'm_collision_meshes'
+    bool loadCachedCollisionMesh(collision_mesh_t& cmesh); /// Fills `cmesh.tris` if the cache has a record with matching fingerprint
+    int registerCollisionMesh(collision_mesh_t& cmesh); /// Returns index to 'm_collision_meshes'
+    int addCollisionMeshInstance(int mesh_index, Ogre::Vector3 pos, Ogre::Quaternion q, float scale, ground_model_t* gm);
+    /// Finds the nearest tri of the instance whose collision volume contains the point; updates 'mindist' (world units).
+    const collision_tri_t* findMeshInstanceTri(const collision_mesh_instance_t& inst, const Ogre::Vector3& pos, float& mindist, Ogre::Vector3& point);
+
 public:
 
     std::mutex m_scriptcallback_mutex;
@@ -167,14 +280,22 @@ public:
     bool isInside(Ogre::Vector3 pos, collision_box_t* cbox, float border = 0);
     bool nodeCollision(node_t* node, float dt, bool envokeScriptCallbacks = true);
 
+    /// Loads precomputed collision geometry (mesh-space meshes, world-space tris) of the terrain, if up to date.
+    /// Cached data is verified as the terrain loads; the cache is rewritten by `finishLoadingTerrain()` if anything differs.
+    void setupCollisionCache(CacheEntry const& terrn_entry);
     void finishLoadingTerrain();
+    /// Loads and triangulates the listed collision meshes up front, using the thread pool. Names must be unique.
+    void prepareCollisionMeshes(std::vector<Ogre::String> const& meshnames);
 
     int addCollisionBox(Ogre::SceneNode* tenode, bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String& eventname, const Ogre::String& instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc = Ogre::Vector3::UNIT_SCALE, Ogre::Vector3 dr = Ogre::Vector3::ZERO, CollisionEventFilter event_filter = EVENT_ALL, int scripthandler = -1);
-    int addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0);
+    /// Small meshes with uniform scale are instanced (stored once in mesh space); others are added as world-space tris.
+    /// To be able to remove the mesh later, supply both 'collTris' and 'collMeshInstances' - either may receive the result.
+    int addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0, std::vector<int>* collMeshInstances = 0);
     int addCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm);
     int createCollisionDebugVisualization();
     void removeCollisionBox(int number);
     void removeCollisionTri(int number);
+    void removeCollisionMeshInstance(int number);
     void clearEventCache() { m_last_called_cboxes.clear(); }
 
     Ogre::AxisAlignedBox getCollisionAAB() { return m_collision_aab; };
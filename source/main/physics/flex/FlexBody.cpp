@@ -25,11 +25,15 @@
 #include "ApproxMath.h"
 #include "SimData.h"
 #include "FlexFactory.h"
+#include "FlexNodeIndex.h"
 #include "GfxActor.h"
 #include "GfxScene.h"
 #include "RigDef_File.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
+#include <map>
+#include <tuple>
 
 using namespace Ogre;
 using namespace RoR;
@@ -65,6 +69,8 @@ FlexBody::FlexBody(
 {
 
     Ogre::Vector3* vertices = nullptr;
+    Ogre::Vector3* src_normals = nullptr; // Only if not loaded from cache
+    Locator_t* locators = nullptr; // Only if not loaded from cache
 
     Vector3 normal = Vector3::UNIT_Y;
     Vector3 position = Vector3::ZERO;
@@ -253,14 +259,18 @@ FlexBody::FlexBody(
     double stat_located_time = -1;
     if (preloaded_from_cache != nullptr)
     {
-        m_dst_pos     = preloaded_from_cache->dst_pos;
-        m_src_normals = preloaded_from_cache->src_normals;
-        m_locators    = preloaded_from_cache->locators;
+        // Locators and normals are never modified - share them with other instances
+        m_src_normals   = preloaded_from_cache->src_normals;
+        m_locators      = preloaded_from_cache->locators;
+        m_cache_mapping = preloaded_from_cache->mapping;
+        m_dst_pos     = (Vector3*)malloc(sizeof(Vector3)*m_vertex_count); // Use malloc() for compatibility
         m_dst_normals = (Vector3*)malloc(sizeof(Vector3)*m_vertex_count); // Use malloc() for compatibility
+        memcpy(m_dst_pos, preloaded_from_cache->dst_pos, sizeof(Vector3)*m_vertex_count);
 
         if (m_has_texture_blend)
         {
-            m_src_colors = preloaded_from_cache->src_colors;
+            m_src_colors = (ARGB*)malloc(sizeof(ARGB)*m_vertex_count);
+            memcpy(m_src_colors, preloaded_from_cache->src_colors, sizeof(ARGB)*m_vertex_count);
         }
 
         if (mesh->sharedVertexData)
@@ -308,7 +318,8 @@ FlexBody::FlexBody(
     {
         vertices=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
         m_dst_pos=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
-        m_src_normals=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
+        src_normals=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
+        m_src_normals=src_normals;
         m_dst_normals=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
         if (m_has_texture_blend)
         {
@@ -316,7 +327,7 @@ FlexBody::FlexBody(
             for (int i=0; i<(int)m_vertex_count; i++) m_src_colors[i]=0x00000000;
         }
         Vector3* vpt=vertices;
-        Vector3* npt=m_src_normals;
+        Vector3* npt=src_normals;
         if (mesh->sharedVertexData)
         {
             m_shared_buf_num_verts=(int)mesh->sharedVertexData->vertexCount;
@@ -375,95 +386,91 @@ FlexBody::FlexBody(
             vertices[i]=(orientation*vertices[i])+position;
         }
 
-        m_locators = new Locator_t[m_vertex_count];
-        for (int i=0; i<(int)m_vertex_count; i++)
+        // Index the nodes for nearest-node searches; the results are identical to a linear scan of `node_indices`
+        FlexNodeIndex node_index_tree;
+        for (auto node_index : node_indices)
         {
-            //search nearest node as the local origin
-            float closest_node_distance = std::numeric_limits<float>::max();
-            int closest_node_index = -1;
-            for (auto node_index : node_indices)
-            {
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
-                }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": REF node not found");
-                closest_node_index = 0;
-            }
-            m_locators[i].ref=closest_node_index;            
+            node_index_tree.AddNode(node_index, nodes[node_index].AbsPosition);
+        }
+        node_index_tree.Build();
 
-            //search the second nearest node as the X vector
-            closest_node_distance = std::numeric_limits<float>::max();
-            closest_node_index = -1;
-            for (auto node_index : node_indices)
+        locators = new Locator_t[m_vertex_count];
+        m_locators = locators;
+        auto compute_locators = [locators, vertices, nodes, def, &node_index_tree](int begin, int end)
+        {
+            for (int i=begin; i<end; i++)
             {
-                if (node_index == m_locators[i].ref)
+                //search nearest node as the local origin
+                int closest_node_index = node_index_tree.FindNearest(vertices[i], [](unsigned int) { return true; });
+                if (closest_node_index == -1)
                 {
-                    continue;
+                    LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": REF node not found");
+                    closest_node_index = 0;
                 }
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
-                }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VX node not found");
-                closest_node_index = 0;
-            }
-            m_locators[i].nx=closest_node_index;
+                locators[i].ref=closest_node_index;
 
-            //search another close, orthogonal node as the Y vector
-            closest_node_distance = std::numeric_limits<float>::max();
-            closest_node_index = -1;
-            Vector3 vx = (nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
-            for (auto node_index : node_indices)
-            {
-                if (node_index == m_locators[i].ref || node_index == m_locators[i].nx)
+                //search the second nearest node as the X vector
+                const unsigned int ref = static_cast<unsigned int>(locators[i].ref);
+                closest_node_index = node_index_tree.FindNearest(vertices[i], [ref](unsigned int node_index) { return node_index != ref; });
+                if (closest_node_index == -1)
                 {
-                    continue;
+                    LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VX node not found");
+                    closest_node_index = 0;
                 }
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    Vector3 vt = (nodes[node_index].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
-                    float cost = vx.dotProduct(vt);
-                    if (std::abs(cost) > std::sqrt(2.0f) / 2.0f)
+                locators[i].nx=closest_node_index;
+
+                //search another close, orthogonal node as the Y vector
+                const unsigned int nx = static_cast<unsigned int>(locators[i].nx);
+                Vector3 vx = (nodes[locators[i].nx].AbsPosition - nodes[locators[i].ref].AbsPosition).normalisedCopy();
+                closest_node_index = node_index_tree.FindNearest(vertices[i], [ref, nx, nodes, vx](unsigned int node_index)
                     {
-                        continue; //rejection, fails the orthogonality criterion (+-45 degree)
-                    }
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
+                        if (node_index == ref || node_index == nx)
+                        {
+                            return false;
+                        }
+                        Vector3 vt = (nodes[node_index].AbsPosition - nodes[ref].AbsPosition).normalisedCopy();
+                        float cost = vx.dotProduct(vt);
+                        return !(std::abs(cost) > std::sqrt(2.0f) / 2.0f); //rejection, fails the orthogonality criterion (+-45 degree)
+                    });
+                if (closest_node_index == -1)
+                {
+                    LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VY node not found");
+                    closest_node_index = 0;
                 }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VY node not found");
-                closest_node_index = 0;
-            }
-            m_locators[i].ny=closest_node_index;
+                locators[i].ny=closest_node_index;
 
-            Matrix3 mat;
-            Vector3 diffX = nodes[m_locators[i].nx].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
-            Vector3 diffY = nodes[m_locators[i].ny].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
+                Matrix3 mat;
+                Vector3 diffX = nodes[locators[i].nx].AbsPosition-nodes[locators[i].ref].AbsPosition;
+                Vector3 diffY = nodes[locators[i].ny].AbsPosition-nodes[locators[i].ref].AbsPosition;
 
-            mat.SetColumn(0, diffX);
-            mat.SetColumn(1, diffY);
-            mat.SetColumn(2, (diffX.crossProduct(diffY)).normalisedCopy()); // Old version: mat.SetColumn(2, nodes[loc.nz].AbsPosition-nodes[loc.ref].AbsPosition);
+                mat.SetColumn(0, diffX);
+                mat.SetColumn(1, diffY);
+                mat.SetColumn(2, (diffX.crossProduct(diffY)).normalisedCopy()); // Old version: mat.SetColumn(2, nodes[loc.nz].AbsPosition-nodes[loc.ref].AbsPosition);
 
-            mat = mat.Inverse();
+                mat = mat.Inverse();
 
-            //compute coordinates in the newly formed Euclidean basis
-            m_locators[i].coords = mat * (vertices[i] - nodes[m_locators[i].ref].AbsPosition);
+                //compute coordinates in the newly formed Euclidean basis
+                locators[i].coords = mat * (vertices[i] - nodes[locators[i].ref].AbsPosition);
 
-            // that's it!
+                // that's it!
+            }
+        };
+
+        // Vertices are independent - split big meshes among worker threads
+        const int LOCATOR_TASK_SIZE = 4096;
+        if ((int)m_vertex_count > LOCATOR_TASK_SIZE)
+        {
+            std::vector<std::function<void()>> tasks;
+            for (int begin = 0; begin < (int)m_vertex_count; begin += LOCATOR_TASK_SIZE)
+            {
+                const int end = std::min(begin + LOCATOR_TASK_SIZE, (int)m_vertex_count);
+                tasks.push_back([compute_locators, begin, end]() { compute_locators(begin, end); });
+            }
+            App::GetThreadPool()->Parallelize(tasks);
+        }
+        else
+        {
+            compute_locators(0, (int)m_vertex_count);
         }
 
     } // if (preloaded_from_cache == nullptr)
@@ -505,10 +512,12 @@ FlexBody::FlexBody(
             mat = mat.Inverse();
 
             // compute coordinates in the Euclidean basis
-            m_src_normals[i] = mat*(orientation * m_src_normals[i]);
+            src_normals[i] = mat*(orientation * src_normals[i]);
         }
     }
 
+    this->BuildLocatorFrames();
+
     if (vertices != nullptr) { free(vertices); }
 
 #ifdef FLEXBODY_LOG_LOADING_TIMES
@@ -534,10 +543,13 @@ FlexBody::FlexBody(
 
 FlexBody::~FlexBody()
 {
-    // Stuff using <new>
-    if (m_locators != nullptr) { delete[] m_locators; }
+    // Stuff shared via flexbody cache, or owned
+    if (m_cache_mapping == nullptr)
+    {
+        if (m_locators != nullptr) { delete[] m_locators; } // Uses <new>
+        if (m_src_normals != nullptr) { free((void*)m_src_normals); } // Uses malloc()
+    }
     // Stuff using malloc()
-    if (m_src_normals != nullptr) { free(m_src_normals); }
     if (m_dst_normals != nullptr) { free(m_dst_normals); }
     if (m_dst_pos     != nullptr) { free(m_dst_pos    ); }
     if (m_src_colors  != nullptr) { free(m_src_colors ); }
@@ -630,28 +642,141 @@ void FlexBody::ComputeFlexbody()
         m_flexit_center = nodes[0].AbsPosition;
     }
 
-    for (int i=0; i<(int)m_vertex_count; i++)
+    m_deformed_orientation = this->ComputeReferenceOrientation();
+    m_rigid_rotation = Quaternion::IDENTITY;
+    m_vertices_changed = true;
+    m_has_deformed = true;
+
+    // Node frames - computed once for all vertices sharing the (ref, nx, ny) triplet
+    for (LocatorFrame& frame : m_locator_frames)
+    {
+        frame.axis_x = nodes[frame.nx].AbsPosition - nodes[frame.ref].AbsPosition;
+        frame.axis_y = nodes[frame.ny].AbsPosition - nodes[frame.ref].AbsPosition;
+        frame.axis_n = fast_normalise(frame.axis_x.crossProduct(frame.axis_y));
+        frame.origin = nodes[frame.ref].AbsPosition - m_flexit_center;
+    }
+
+    // Vertices - gathered into SoA batches of fixed size, so the compiler can vectorize the math
+    const int BATCH = 8;
+    const int vertex_count = (int)m_vertex_count;
+    float ax[3][BATCH], ay[3][BATCH], an[3][BATCH], org[3][BATCH]; // Frames
+    float coords[3][BATCH], src_norm[3][BATCH];
+    float pos[3][BATCH], norm[3][BATCH];
+    for (int start = 0; start < vertex_count; start += BATCH)
+    {
+        const int count = std::min(BATCH, vertex_count - start);
+        for (int k = 0; k < BATCH; k++)
+        {
+            const int i = start + std::min(k, count - 1); // Pad the last batch with duplicates
+            LocatorFrame const& frame = m_locator_frames[m_vertex_frames[i]];
+            for (int c = 0; c < 3; c++)
+            {
+                ax[c][k]       = frame.axis_x[c];
+                ay[c][k]       = frame.axis_y[c];
+                an[c][k]       = frame.axis_n[c];
+                org[c][k]      = frame.origin[c];
+                coords[c][k]   = m_locators[i].coords[c];
+                src_norm[c][k] = m_src_normals[i][c];
+            }
+        }
+
+        for (int c = 0; c < 3; c++)
+        {
+            for (int k = 0; k < BATCH; k++)
+            {
+                pos[c][k]  = (ax[c][k] * coords[0][k] + ay[c][k] * coords[1][k] + an[c][k] * coords[2][k]) + org[c][k];
+                norm[c][k] = ax[c][k] * src_norm[0][k] + ay[c][k] * src_norm[1][k] + an[c][k] * src_norm[2][k];
+            }
+        }
+        for (int k = 0; k < BATCH; k++)
+        {
+            const float inv_len = 1.f / std::sqrt(norm[0][k] * norm[0][k] + norm[1][k] * norm[1][k] + norm[2][k] * norm[2][k]);
+            norm[0][k] *= inv_len;
+            norm[1][k] *= inv_len;
+            norm[2][k] *= inv_len;
+        }
+
+        for (int k = 0; k < count; k++)
+        {
+            m_dst_pos[start + k]     = Vector3(pos[0][k], pos[1][k], pos[2][k]);
+            m_dst_normals[start + k] = Vector3(norm[0][k], norm[1][k], norm[2][k]);
+        }
+    }
+}
+
+void FlexBody::ResetDeformation()
+{
+    m_deformed_orientation = Quaternion::IDENTITY;
+    m_rigid_rotation = Quaternion::IDENTITY;
+    m_has_deformed = false;
+}
+
+void FlexBody::ComputeFlexbodyRigid()
+{
+    RoR::GfxActor::SimBuffer::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+
+    if (m_node_center >= 0)
     {
-        Vector3 diffX = nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 diffY = nodes[m_locators[i].ny].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 nCross = fast_normalise(diffX.crossProduct(diffY)); //nCross.normalise();
+        Vector3 diffX = nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition;
+        Vector3 diffY = nodes[m_node_y].AbsPosition - nodes[m_node_center].AbsPosition;
+        Vector3 flexit_normal = fast_normalise(diffY.crossProduct(diffX));
 
-        m_dst_pos[i].x = diffX.x * m_locators[i].coords.x + diffY.x * m_locators[i].coords.y + nCross.x * m_locators[i].coords.z;
-        m_dst_pos[i].y = diffX.y * m_locators[i].coords.x + diffY.y * m_locators[i].coords.y + nCross.y * m_locators[i].coords.z;
-        m_dst_pos[i].z = diffX.z * m_locators[i].coords.x + diffY.z * m_locators[i].coords.y + nCross.z * m_locators[i].coords.z;
+        m_flexit_center = nodes[m_node_center].AbsPosition + m_center_offset.x * diffX + m_center_offset.y * diffY;
+        m_flexit_center += m_center_offset.z * flexit_normal;
+        m_rigid_rotation = this->ComputeReferenceOrientation() * m_deformed_orientation.Inverse();
+    }
+    else
+    {
+        m_flexit_center = nodes[0].AbsPosition;
+    }
+}
 
-        m_dst_pos[i] += nodes[m_locators[i].ref].AbsPosition - m_flexit_center;
+Quaternion FlexBody::ComputeReferenceOrientation()
+{
+    if (m_node_center < 0)
+    {
+        return Quaternion::IDENTITY;
+    }
 
-        m_dst_normals[i].x = diffX.x * m_src_normals[i].x + diffY.x * m_src_normals[i].y + nCross.x * m_src_normals[i].z;
-        m_dst_normals[i].y = diffX.y * m_src_normals[i].x + diffY.y * m_src_normals[i].y + nCross.y * m_src_normals[i].z;
-        m_dst_normals[i].z = diffX.z * m_src_normals[i].x + diffY.z * m_src_normals[i].y + nCross.z * m_src_normals[i].z;
+    RoR::GfxActor::SimBuffer::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+    Vector3 axis_x = (nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition).normalisedCopy();
+    Vector3 axis_z = axis_x.crossProduct(nodes[m_node_y].AbsPosition - nodes[m_node_center].AbsPosition).normalisedCopy();
+    Vector3 axis_y = axis_z.crossProduct(axis_x);
+    return Quaternion(axis_x, axis_y, axis_z);
+}
 
-        m_dst_normals[i] = fast_normalise(m_dst_normals[i]);
+void FlexBody::BuildLocatorFrames()
+{
+    std::map<std::tuple<int, int, int>, int> frame_lookup;
+    m_vertex_frames.resize(m_vertex_count);
+    for (int i=0; i<(int)m_vertex_count; i++)
+    {
+        auto key = std::make_tuple(m_locators[i].ref, m_locators[i].nx, m_locators[i].ny);
+        auto found = frame_lookup.find(key);
+        if (found == frame_lookup.end())
+        {
+            LocatorFrame frame;
+            frame.ref = m_locators[i].ref;
+            frame.nx  = m_locators[i].nx;
+            frame.ny  = m_locators[i].ny;
+            found = frame_lookup.insert(std::make_pair(key, (int)m_locator_frames.size())).first;
+            m_locator_frames.push_back(frame);
+        }
+        m_vertex_frames[i] = found->second;
     }
 }
 
 void FlexBody::UpdateFlexbodyVertexBuffers()
 {
+    m_scene_node->setPosition(m_flexit_center);
+    m_scene_node->setOrientation(m_rigid_rotation);
+
+    if (!m_vertices_changed)
+    {
+        return; // Rigid update only, see `ComputeFlexbodyRigid()`
+    }
+    m_vertices_changed = false;
+
     Vector3 *ppt = m_dst_pos;
     Vector3 *npt = m_dst_normals;
     if (m_uses_shared_vertex_data)
@@ -674,8 +799,6 @@ void FlexBody::UpdateFlexbodyVertexBuffers()
         writeBlend();
         m_blend_changed = false;
     }
-
-    m_scene_node->setPosition(m_flexit_center);
 }
 
 void FlexBody::reset()
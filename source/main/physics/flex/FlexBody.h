@@ -29,9 +29,13 @@
 #include <OgreQuaternion.h>
 #include <OgreHardwareVertexBuffer.h>
 #include <OgreMesh.h>
+#include <memory>
+#include <vector>
 
 namespace RoR {
 
+class MappedFile;
+
 /// Flexbody = A deformable mesh; updated on CPU every frame, then uploaded to video memory
 class FlexBody
 {
@@ -65,6 +69,9 @@ public:
     int getCameraMode() { return m_camera_mode; };
 
     void ComputeFlexbody(); //!< Updates mesh deformation; works on CPU using local copy of vertex data.
+    void ComputeFlexbodyRigid(); //!< Cheap alternative (LOD): moves and rotates the last deformed mesh along with its reference nodes.
+    void ResetDeformation(); //!< Forgets the last deformation; call when nodes were moved outside of the physics step.
+    bool HasDeformed() const { return m_has_deformed; } //!< False until `ComputeFlexbody()` ran; `ComputeFlexbodyRigid()` needs a deformed mesh.
     void UpdateFlexbodyVertexBuffers();
 
     void setVisible(bool visible);
@@ -75,15 +82,37 @@ public:
 
 private:
 
+    /// Basis formed by a (ref, nx, ny) node triplet; usually shared by many vertices.
+    struct LocatorFrame
+    {
+        int           ref;
+        int           nx;
+        int           ny;
+        Ogre::Vector3 axis_x;  //!< Updated per frame
+        Ogre::Vector3 axis_y;  //!< Updated per frame
+        Ogre::Vector3 axis_n;  //!< Updated per frame
+        Ogre::Vector3 origin;  //!< Updated per frame; relative to `m_flexit_center`
+    };
+
+    void BuildLocatorFrames();
+    Ogre::Quaternion ComputeReferenceOrientation(); //!< Orientation of the ref/x/y node frame
+
     RoR::GfxActor*    m_gfx_actor;
     size_t            m_vertex_count;
     Ogre::Vector3     m_flexit_center; //!< Updated per frame
-
-    Ogre::Vector3*    m_dst_pos;
-    Ogre::Vector3*    m_src_normals;
-    Ogre::Vector3*    m_dst_normals;
-    Ogre::ARGB*       m_src_colors;
-    Locator_t*        m_locators; //!< 1 loc per vertex
+    Ogre::Quaternion  m_deformed_orientation = Ogre::Quaternion::IDENTITY; //!< Reference frame orientation at last deformation
+    Ogre::Quaternion  m_rigid_rotation = Ogre::Quaternion::IDENTITY;       //!< Applied to the deformed mesh by `ComputeFlexbodyRigid()`
+    bool              m_vertices_changed = false; //!< Vertex buffers need an update
+    bool              m_has_deformed = false;     //!< `m_deformed_orientation` is valid
+
+    Ogre::Vector3*       m_dst_pos;
+    const Ogre::Vector3* m_src_normals; //!< Owned, or shared from flexbody cache (see `m_cache_mapping`)
+    Ogre::Vector3*       m_dst_normals;
+    Ogre::ARGB*          m_src_colors;
+    const Locator_t*     m_locators;    //!< 1 loc per vertex; owned, or shared from flexbody cache (see `m_cache_mapping`)
+    std::shared_ptr<MappedFile> m_cache_mapping; //!< Non-null if `m_src_normals` and `m_locators` point into the flexbody cache.
+    std::vector<LocatorFrame>   m_locator_frames;
+    std::vector<int>            m_vertex_frames; //!< Per vertex: index to `m_locator_frames`
 
     int               m_node_center;
     int               m_node_x;
@@ -26,16 +26,19 @@
 
 #include "Application.h"
 #include "Actor.h"
+#include "CacheSystem.h"
 #include "FlexBody.h"
 #include "FlexMeshWheel.h"
 #include "GfxScene.h"
 #include "PlatformUtils.h"
 #include "RigDef_File.h"
 #include "ActorSpawner.h"
+#include "Utils.h"
 
 #include <OgreMeshManager.h>
 #include <OgreSceneManager.h>
 #include <MeshLodGenerator/OgreMeshLodGenerator.h>
+#include <cstdio>
 
 //#define FLEXFACTORY_DEBUG_LOGGING
 
@@ -50,6 +53,9 @@ using namespace RoR;
 
 // Static
 const char * FlexBodyFileIO::SIGNATURE = "RoR FlexBody";
+std::map<std::string, std::weak_ptr<MappedFile>> FlexBodyFileIO::s_mapped_files;
+
+static_assert(sizeof(FlexBodyRecordHeader) % 4 == 0, "Flexbody cache data must stay aligned when memory-mapped");
 
 FlexFactory::FlexFactory(ActorSpawner* rig_spawner):
     m_rig_spawner(rig_spawner),
@@ -59,6 +65,50 @@ FlexFactory::FlexFactory(ActorSpawner* rig_spawner):
 {
 }
 
+/// The cache is keyed by the actor's bundle, but the mesh may come from elsewhere (i.e. a shared resource group)
+/// and the actor may have changed since - verify the record fits before the flexbody uses it.
+static bool IsCachedFlexbodyValid(FlexBodyCacheData* data, Ogre::MeshPtr const& mesh, int num_nodes, int ref, int nx, int ny)
+{
+    if (data->header.IsFaulty() || data->locators == nullptr ||
+        data->header.node_center != ref || data->header.node_x != nx || data->header.node_y != ny)
+    {
+        return false;
+    }
+
+    int vertex_count = 0;
+    int num_submesh_vbufs = 0;
+    if (mesh->sharedVertexData)
+    {
+        vertex_count += static_cast<int>(mesh->sharedVertexData->vertexCount);
+    }
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+    {
+        if (!mesh->getSubMesh(i)->useSharedVertices)
+        {
+            vertex_count += static_cast<int>(mesh->getSubMesh(i)->vertexData->vertexCount);
+            ++num_submesh_vbufs;
+        }
+    }
+    if (data->header.vertex_count != vertex_count ||
+        data->header.num_submesh_vbufs != num_submesh_vbufs ||
+        data->header.UsesSharedVertexData() != (mesh->sharedVertexData != nullptr))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < vertex_count; ++i)
+    {
+        const Locator_t& loc = data->locators[i];
+        if (loc.ref < 0 || loc.ref >= num_nodes ||
+            loc.nx  < 0 || loc.nx  >= num_nodes ||
+            loc.ny  < 0 || loc.ny  >= num_nodes)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 FlexBody* FlexFactory::CreateFlexBody(
     RigDef::Flexbody* def,
     const int ref_node, 
@@ -83,6 +133,15 @@ FlexBody* FlexFactory::CreateFlexBody(
         FLEX_DEBUG_LOG(__FUNCTION__ " >> Get entry from cache ");
         from_cache = m_flexbody_cache.GetLoadedItem(m_flexbody_cache_next_index);
         m_flexbody_cache_next_index++;
+        if (from_cache == nullptr ||
+            !IsCachedFlexbodyValid(from_cache, mesh, m_rig_spawner->GetActor()->GetNumNodes(), ref_node, x_node, y_node))
+        {
+            // Records are matched by order - once one doesn't fit, don't trust the rest and re-save the cache.
+            RoR::LogFormat("[RoR|Flexbody] Cache record %u doesn't match mesh '%s', discarding flexbody cache",
+                m_flexbody_cache_next_index - 1, def->mesh_name.c_str());
+            from_cache = nullptr;
+            m_is_flexbody_cache_loaded = false;
+        }
     }
 
     FlexBody* new_flexbody = new FlexBody(
@@ -146,27 +205,37 @@ void FlexBodyFileIO::WriteToFile(void* source, size_t length)
     }
 }
 
-void FlexBodyFileIO::ReadFromFile(void* dest, size_t length)
+const void* FlexBodyFileIO::MapFromFile(size_t length)
 {
-    size_t num_written = fread(dest, length, 1, m_file);
-    if (num_written != 1)
+    if (length > m_mapping->GetSize() - m_read_pos)
     {
         FLEX_DEBUG_LOG(__FUNCTION__ " >> EXCEPTION!! ");
         throw RESULT_CODE_FREAD_OUTPUT_INCOMPLETE;
     }
+    const void* data = m_mapping->GetData() + m_read_pos;
+    m_read_pos += length;
+    return data;
+}
+
+void FlexBodyFileIO::ReadFromFile(void* dest, size_t length)
+{
+    memcpy(dest, this->MapFromFile(length), length);
 }
 
 void FlexBodyFileIO::WriteSignature()
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    WriteToFile((void*)SIGNATURE, (strlen(SIGNATURE) + 1) * sizeof(char));
+    char signature[SIGNATURE_LENGTH] = {};
+    strncpy(signature, SIGNATURE, SIGNATURE_LENGTH - 1);
+    WriteToFile((void*)signature, SIGNATURE_LENGTH);
 }
 
 void FlexBodyFileIO::ReadAndCheckSignature()
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    char signature[25];
-    this->ReadFromFile((void*)&signature, (strlen(SIGNATURE) + 1) * sizeof(char));
+    char signature[SIGNATURE_LENGTH];
+    this->ReadFromFile((void*)&signature, SIGNATURE_LENGTH);
+    signature[SIGNATURE_LENGTH - 1] = '\0';
     if (strcmp(SIGNATURE, signature) != 0)
     {
         throw RESULT_CODE_ERR_SIGNATURE_MISMATCH;
@@ -179,6 +248,8 @@ void FlexBodyFileIO::WriteMetadata()
     FlexBodyFileMetadata meta;
     meta.file_format_version = FILE_FORMAT_VERSION;    
     meta.num_flexbodies      = static_cast<int>(m_items_to_save.size());
+    meta.source_size         = m_source_size;
+    meta.source_time         = m_source_time;
 
     this->WriteToFile((void*)&meta, sizeof(FlexBodyFileMetadata));
 }
@@ -225,10 +296,7 @@ void FlexBodyFileIO::WriteFlexbodyLocatorList(FlexBody* flexbody)
 void FlexBodyFileIO::ReadFlexbodyLocatorList(FlexBodyCacheData* data)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    // Alloc. Use <new> - experiment
-    data->locators = new Locator_t[data->header.vertex_count];
-    // Read
-    this->ReadFromFile((void*)data->locators, sizeof(Locator_t) * data->header.vertex_count);
+    data->locators = static_cast<const Locator_t*>(this->MapFromFile(sizeof(Locator_t) * data->header.vertex_count));
 }
 
 void FlexBodyFileIO::WriteFlexbodyNormalsBuffer(FlexBody* flexbody)
@@ -240,11 +308,7 @@ void FlexBodyFileIO::WriteFlexbodyNormalsBuffer(FlexBody* flexbody)
 void FlexBodyFileIO::ReadFlexbodyNormalsBuffer(FlexBodyCacheData* data)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    const int vertex_count = data->header.vertex_count;
-    // Alloc. Use malloc() because that's how flexbodies were implemented.
-    data->src_normals=(Ogre::Vector3*)malloc(sizeof(Ogre::Vector3) * vertex_count);
-    // Read
-    this->ReadFromFile((void*)data->src_normals, sizeof(Ogre::Vector3) * vertex_count);
+    data->src_normals = static_cast<const Ogre::Vector3*>(this->MapFromFile(sizeof(Ogre::Vector3) * data->header.vertex_count));
 }
 
 void FlexBodyFileIO::WriteFlexbodyPositionsBuffer(FlexBody* flexbody)
@@ -256,11 +320,7 @@ void FlexBodyFileIO::WriteFlexbodyPositionsBuffer(FlexBody* flexbody)
 void FlexBodyFileIO::ReadFlexbodyPositionsBuffer(FlexBodyCacheData* data)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    const int vertex_count = data->header.vertex_count;
-    // Alloc. Use malloc() because that's how flexbodies were implemented.
-    data->dst_pos=(Ogre::Vector3*)malloc(sizeof(Ogre::Vector3) * vertex_count);
-    // Read
-    this->ReadFromFile((void*)data->dst_pos, sizeof(Ogre::Vector3) * vertex_count);
+    data->dst_pos = static_cast<const Ogre::Vector3*>(this->MapFromFile(sizeof(Ogre::Vector3) * data->header.vertex_count));
 }
 
 void FlexBodyFileIO::WriteFlexbodyColorsBuffer(FlexBody* flexbody)
@@ -279,29 +339,32 @@ void FlexBodyFileIO::ReadFlexbodyColorsBuffer(FlexBodyCacheData* data)
     {
         return;
     }
-    const int vertex_count = data->header.vertex_count;
-    // Alloc. Use malloc() because that's how flexbodies were implemented.
-    data->src_colors=(Ogre::ARGB*)malloc(sizeof(Ogre::ARGB) * vertex_count);
-    // Read
-    this->ReadFromFile((void*)data->src_colors, sizeof(Ogre::ARGB) * vertex_count);
+    data->src_colors = static_cast<const Ogre::ARGB*>(this->MapFromFile(sizeof(Ogre::ARGB) * data->header.vertex_count));
 }
 
 void FlexBodyFileIO::OpenFile(const char* fopen_mode)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    if (m_cache_entry_number == -1)
+    if (m_cache_filename.empty())
     {
         throw RESULT_CODE_ERR_CACHE_NUMBER_UNDEFINED;
     }
-    char path[500];
-    sprintf(path, "%s%cflexbodies_mod_%00d.dat", App::sys_cache_dir->GetStr().c_str(), RoR::PATH_SLASH, m_cache_entry_number);
-    m_file = fopen(path, fopen_mode);
+    // Write to a temporary file and swap it in when complete - the old one may be mapped by living actors.
+    const std::string path = PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename) + ".tmp";
+    m_file = fopen(path.c_str(), fopen_mode);
     if (m_file == nullptr)
     {
         throw RESULT_CODE_ERR_FOPEN_FAILED;
     }
 }
 
+void FlexBodyFileIO::SetCacheFile(std::string const& filename, uint64_t source_size, int64_t source_time)
+{
+    m_cache_filename = filename;
+    m_source_size = source_size;
+    m_source_time = source_time;
+}
+
 FlexBodyFileIO::ResultCode FlexBodyFileIO::SaveFile()
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
@@ -330,6 +393,15 @@ FlexBodyFileIO::ResultCode FlexBodyFileIO::SaveFile()
             this->WriteFlexbodyColorsBuffer   (flexbody);
         }
         this->CloseFile();
+
+        // On Windows, replacing fails while the old file is mapped; the cache will be updated later.
+        const std::string path = PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename);
+        std::remove(path.c_str());
+        if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0)
+        {
+            std::remove((path + ".tmp").c_str());
+            return RESULT_CODE_ERR_FOPEN_FAILED;
+        }
         FLEX_DEBUG_LOG(__FUNCTION__ " >> OK ");
         return RESULT_CODE_OK;
     }
@@ -344,49 +416,94 @@ FlexBodyFileIO::ResultCode FlexBodyFileIO::SaveFile()
 FlexBodyFileIO::ResultCode FlexBodyFileIO::LoadFile()
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    try 
+    if (m_cache_filename.empty())
     {
-        this->OpenFile("rb");
-        this->ReadAndCheckSignature();
+        return RESULT_CODE_ERR_CACHE_NUMBER_UNDEFINED;
+    }
 
-        FlexBodyFileMetadata meta;
-        this->ReadMetadata(&meta);
-        m_fileformat_version = meta.file_format_version;
-        if (m_fileformat_version != FILE_FORMAT_VERSION)
+    // Forget mappings whose actors are all gone
+    for (auto itor = s_mapped_files.begin(); itor != s_mapped_files.end(); )
+    {
+        if (itor->second.expired())
+        {
+            itor = s_mapped_files.erase(itor);
+        }
+        else
         {
-            throw RESULT_CODE_ERR_VERSION_MISMATCH;
+            ++itor;
         }
-        m_loaded_items.resize(meta.num_flexbodies);
+    }
 
-        for (unsigned int i = 0; i < meta.num_flexbodies; ++i)
+    // Re-use the mapping if another instance of this actor exists
+    const std::string path = PathCombine(App::sys_cache_dir->GetStr(), m_cache_filename);
+    m_mapping = s_mapped_files[path].lock();
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        if (m_mapping == nullptr)
         {
-            FlexBodyCacheData* data = & m_loaded_items[i];
-            this->ReadFlexbodyHeader(data);
-            if (!data->header.IsFaulty())
+            m_mapping = std::make_shared<MappedFile>();
+            if (!m_mapping->Open(path))
             {
-                this->ReadFlexbodyLocatorList    (data);
-                this->ReadFlexbodyPositionsBuffer(data);
-                this->ReadFlexbodyNormalsBuffer  (data);
-                this->ReadFlexbodyColorsBuffer   (data);
+                m_mapping.reset();
+                return RESULT_CODE_ERR_FOPEN_FAILED;
             }
+            s_mapped_files[path] = m_mapping;
         }
 
-        this->CloseFile();
-        FLEX_DEBUG_LOG(__FUNCTION__ " >> OK ");
-        return RESULT_CODE_OK;
-    }
-    catch (ResultCode ret)
-    {
-        this->CloseFile();
-        FLEX_DEBUG_LOG(__FUNCTION__ " >> EXCEPTION!! ");
-        return ret;
+        try
+        {
+            m_read_pos = 0;
+            this->ReadAndCheckSignature();
+
+            FlexBodyFileMetadata meta;
+            this->ReadMetadata(&meta);
+            m_fileformat_version = meta.file_format_version;
+            if (m_fileformat_version != FILE_FORMAT_VERSION ||
+                meta.source_size != m_source_size || meta.source_time != m_source_time)
+            {
+                throw RESULT_CODE_ERR_VERSION_MISMATCH;
+            }
+            m_loaded_items.clear();
+            m_loaded_items.resize(meta.num_flexbodies);
+
+            for (unsigned int i = 0; i < meta.num_flexbodies; ++i)
+            {
+                FlexBodyCacheData* data = & m_loaded_items[i];
+                this->ReadFlexbodyHeader(data);
+                data->mapping = m_mapping;
+                if (!data->header.IsFaulty())
+                {
+                    this->ReadFlexbodyLocatorList    (data);
+                    this->ReadFlexbodyPositionsBuffer(data);
+                    this->ReadFlexbodyNormalsBuffer  (data);
+                    this->ReadFlexbodyColorsBuffer   (data);
+                }
+            }
+
+            FLEX_DEBUG_LOG(__FUNCTION__ " >> OK ");
+            return RESULT_CODE_OK;
+        }
+        catch (ResultCode ret)
+        {
+            FLEX_DEBUG_LOG(__FUNCTION__ " >> EXCEPTION!! ");
+            m_loaded_items.clear();
+            m_mapping.reset();
+            if (attempt == 1)
+            {
+                return ret;
+            }
+            // The shared mapping may predate an update of the file - try the file on disk.
+        }
     }
+    return RESULT_CODE_GENERAL_ERROR;
 }
 
 FlexBodyFileIO::FlexBodyFileIO():
     m_file(nullptr),
+    m_read_pos(0),
     m_fileformat_version(0),
-    m_cache_entry_number(-1) // flexbody cache disabled (shouldn't be based on the cache entry number ...) ~ ulteq 01/19
+    m_source_size(0),
+    m_source_time(0)
     {}
 
 void FlexFactory::CheckAndLoadFlexbodyCache()
@@ -394,6 +511,21 @@ void FlexFactory::CheckAndLoadFlexbodyCache()
     FLEX_DEBUG_LOG(__FUNCTION__);
     if (m_is_flexbody_cache_enabled)
     {
+        // The cache is only valid for the actor's source ZIP/file and the selected section config
+        Actor* actor = m_rig_spawner->GetActor();
+        CacheEntry* entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, actor->ar_filename);
+        uint64_t source_size = 0;
+        std::time_t source_time = 0;
+        if (entry == nullptr || !RoR::GetFileSizeAndTime(CacheSystem::GetFingerprintPath(*entry), source_size, source_time))
+        {
+            m_is_flexbody_cache_enabled = false;
+            return;
+        }
+        const std::string key = entry->resource_bundle_path + "|" + entry->fname + "|" + actor->GetSectionConfig();
+        m_flexbody_cache.SetCacheFile(
+            "flexbodies_" + HashData(key.c_str(), static_cast<int>(key.size())) + ".dat",
+            source_size, static_cast<int64_t>(source_time));
+
         m_is_flexbody_cache_loaded = 
             (m_flexbody_cache.LoadFile() == FlexBodyFileIO::RESULT_CODE_OK);
     }
@@ -34,11 +34,16 @@
 
 #include <OgreVector3.h>
 #include <OgreColourValue.h>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace RoR
 {
 
+class MappedFile;
+
 struct FlexBodyRecordHeader
 {
     FlexBodyRecordHeader():
@@ -61,6 +66,8 @@ struct FlexBodyRecordHeader
     BITMASK_PROPERTY(flags, 4, HAS_TEXTURE_BLEND,      HasTextureBlend     , SetHasTextureBlend      );
 };
 
+/// Points into the memory-mapped cache file, which is shared by all instances of the same actor.
+/// Immutable data (locators, normals) is used in place; the rest is copied to each FlexBody instance.
 struct FlexBodyCacheData
 {
     FlexBodyCacheData():
@@ -70,20 +77,20 @@ struct FlexBodyCacheData
         locators(nullptr)
     {}
 
-    // NOTE: No freeing of memory needed, pointers will be copied to FlexBody instances.
-
     FlexBodyRecordHeader header;
 
-    Ogre::Vector3*    dst_pos;
-    Ogre::Vector3*    src_normals;
-    Ogre::ARGB*       src_colors;
-    Locator_t*        locators; //!< 1 loc per vertex
+    const Ogre::Vector3* dst_pos;     //!< Copied
+    const Ogre::Vector3* src_normals; //!< Shared
+    const Ogre::ARGB*    src_colors;  //!< Copied
+    const Locator_t*     locators;    //!< Shared; 1 loc per vertex
+    std::shared_ptr<MappedFile> mapping; //!< Keeps the above pointers valid
 };
 
 /// Enables saving and loading flexbodies from/to binary file.
+/// The file is memory-mapped for reading and the mapping is shared by all instances of the actor.
 ///
 /// FILE STRUCTURE:
-/// 1. Signature
+/// 1. Signature (padded to 16 bytes)
 /// 2. Metadata @see FlexBodyFileMetadata
 /// 3. Flexbodies
 ///     a. Header @see FlexBodyRecordHeader
@@ -108,13 +115,15 @@ public:
     };
 
     static const char*        SIGNATURE;
-    static const unsigned int FILE_FORMAT_VERSION = 1;
+    static const size_t       SIGNATURE_LENGTH = 16;
+    static const unsigned int FILE_FORMAT_VERSION = 2;
 
     FlexBodyFileIO();
 
     std::vector<FlexBody*> &  GetList();
     inline void               AddItemToSave(FlexBody* fb)     { m_items_to_save.push_back(fb); }
-    inline FlexBodyCacheData* GetLoadedItem(unsigned index)   { return & m_loaded_items[index]; }
+    inline FlexBodyCacheData* GetLoadedItem(unsigned index)   { return (index < m_loaded_items.size()) ? & m_loaded_items[index] : nullptr; }
+    void                      SetCacheFile(std::string const& filename, uint64_t source_size, int64_t source_time);
     ResultCode                SaveFile();
     ResultCode                LoadFile();
 
@@ -123,12 +132,15 @@ private:
     {
         unsigned int   file_format_version;
         unsigned int   num_flexbodies;
+        uint64_t       source_size; //!< Fingerprint of the source ZIP/file
+        int64_t        source_time; //!< Fingerprint of the source ZIP/file
     };
 
     void        OpenFile(const char* fopen_mode);
     void        WriteToFile(void* source, size_t length);
+    const void* MapFromFile(size_t length);                 //!< Returns pointer to mapped data and advances the read position
     void        ReadFromFile(void* dest, size_t length);
-    inline void CloseFile()                                 { if (m_file != nullptr) { fclose(m_file); } }
+    inline void CloseFile()                                 { if (m_file != nullptr) { fclose(m_file); m_file = nullptr; } }
                 
     void        WriteSignature();
     void         ReadAndCheckSignature();
@@ -154,8 +166,14 @@ private:
     std::vector<FlexBody*>          m_items_to_save;
     std::vector<FlexBodyCacheData>  m_loaded_items;
     FILE*                           m_file;
+    std::shared_ptr<MappedFile>     m_mapping;
+    size_t                          m_read_pos;
     unsigned int                    m_fileformat_version;
-    int                             m_cache_entry_number;
+    std::string                     m_cache_filename;   //!< Empty = flexbody cache disabled
+    uint64_t                        m_source_size;
+    int64_t                         m_source_time;
+
+    static std::map<std::string, std::weak_ptr<MappedFile>> s_mapped_files; //!< Shares mappings among instances of the same actor.
 };
 
 class FlexFactory
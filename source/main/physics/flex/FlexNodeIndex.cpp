@@ -0,0 +1,71 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "FlexNodeIndex.h"
+
+#include <algorithm>
+
+using namespace RoR;
+
+void FlexNodeIndex::AddNode(unsigned int node_index, Ogre::Vector3 const& pos)
+{
+    Entry entry;
+    entry.pos = pos;
+    entry.node_index = node_index;
+    entry.order = static_cast<int>(m_entries.size());
+    entry.split_axis = 0;
+    m_entries.push_back(entry);
+}
+
+void FlexNodeIndex::Build()
+{
+    this->BuildSubtree(0, static_cast<int>(m_entries.size()));
+}
+
+void FlexNodeIndex::BuildSubtree(int begin, int end)
+{
+    if (end - begin < 2)
+    {
+        return;
+    }
+
+    // Split by the axis with the widest spread
+    Ogre::Vector3 min_pos = m_entries[begin].pos;
+    Ogre::Vector3 max_pos = m_entries[begin].pos;
+    for (int i = begin + 1; i < end; ++i)
+    {
+        min_pos.makeFloor(m_entries[i].pos);
+        max_pos.makeCeil(m_entries[i].pos);
+    }
+    const Ogre::Vector3 extent = max_pos - min_pos;
+    int axis = 0;
+    if (extent.y > extent[axis]) { axis = 1; }
+    if (extent.z > extent[axis]) { axis = 2; }
+
+    const int mid = (begin + end) / 2;
+    std::nth_element(m_entries.begin() + begin, m_entries.begin() + mid, m_entries.begin() + end,
+        [axis](Entry const& a, Entry const& b) { return a.pos[axis] < b.pos[axis]; });
+    m_entries[mid].split_axis = axis;
+
+    this->BuildSubtree(begin, mid);
+    this->BuildSubtree(mid + 1, end);
+}
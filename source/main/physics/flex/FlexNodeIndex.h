@@ -0,0 +1,112 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief  Nearest-node lookup for building flexbody vertex locators.
+
+#pragma once
+
+#include <OgreVector3.h>
+#include <limits>
+#include <vector>
+
+namespace RoR
+{
+
+/// Static kd-tree over the nodes a flexbody is attached to.
+/// Queries give the same result as a linear scan of the node list: on equal distance, the node listed first wins.
+/// Read-only after construction, so it can be queried from multiple threads at once.
+class FlexNodeIndex
+{
+public:
+    void AddNode(unsigned int node_index, Ogre::Vector3 const& pos); //!< Nodes are ranked in order of adding.
+    void Build(); //!< Call after adding all nodes.
+
+    /// @param filter Callable `bool(unsigned int node_index)`, rejects candidate nodes.
+    /// @return Index of the nearest accepted node, or -1 if none.
+    template <typename F> int FindNearest(Ogre::Vector3 const& pos, F filter) const
+    {
+        Result result;
+        this->Search(0, static_cast<int>(m_entries.size()), pos, filter, result);
+        return result.node_index;
+    }
+
+private:
+    struct Entry
+    {
+        Ogre::Vector3 pos;
+        unsigned int  node_index;
+        int           order;      //!< Position in the input node list
+        int           split_axis; //!< The entry splits its subtree by this axis
+    };
+
+    struct Result
+    {
+        float         distance = std::numeric_limits<float>::max(); //!< Squared
+        int           order = std::numeric_limits<int>::max();
+        int           node_index = -1;
+    };
+
+    void BuildSubtree(int begin, int end);
+
+    template <typename F> void Search(int begin, int end, Ogre::Vector3 const& pos, F& filter, Result& result) const
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        // Subtree is stored in-order: [begin, mid) <= split <= (mid, end)
+        const int mid = (begin + end) / 2;
+        Entry const& entry = m_entries[mid];
+        const float distance = pos.squaredDistance(entry.pos);
+        if ((distance < result.distance || (distance == result.distance && entry.order < result.order))
+            && filter(entry.node_index))
+        {
+            result.distance = distance;
+            result.order = entry.order;
+            result.node_index = static_cast<int>(entry.node_index);
+        }
+
+        const float delta = pos[entry.split_axis] - entry.pos[entry.split_axis];
+        if (delta < 0.f)
+        {
+            this->Search(begin, mid, pos, filter, result);
+            if (delta * delta <= result.distance)
+            {
+                this->Search(mid + 1, end, pos, filter, result);
+            }
+        }
+        else
+        {
+            this->Search(mid + 1, end, pos, filter, result);
+            if (delta * delta <= result.distance)
+            {
+                this->Search(begin, mid, pos, filter, result);
+            }
+        }
+    }
+
+    std::vector<Entry> m_entries;
+};
+
+} // namespace RoR
@@ -48,11 +48,177 @@
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/writer.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <unordered_map>
 
 using namespace Ogre;
 using namespace RoR;
 
+// --------------------------------------------------------------------------------
+// Binary cache file
+// Layout: [header][entries][authors][sectionconfigs][string table]
+// Records are fixed-size and reference strings by offset+length, so loading
+// is a straight copy out of the memory-mapped file.
+
+namespace {
+
+const char CACHE_FILE_MAGIC[8] = { 'R', 'o', 'R', 'C', 'a', 'c', 'h', 'e' };
+
+struct CacheFileStr
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct CacheFileHeader
+{
+    char         magic[8];
+    uint32_t     format_version;
+    uint32_t     num_entries;
+    uint32_t     num_authors;
+    uint32_t     num_sectionconfigs;
+    uint32_t     strings_size;
+    CacheFileStr global_hash;
+    uint32_t     _reserved;
+};
+
+struct CacheFileAuthor
+{
+    CacheFileStr type;
+    CacheFileStr name;
+    CacheFileStr email;
+    int32_t      id;
+};
+
+struct CacheFileEntry
+{
+    CacheFileStr resource_bundle_type;
+    CacheFileStr resource_bundle_path;
+    CacheFileStr fpath;
+    CacheFileStr fname;
+    CacheFileStr fname_without_uid;
+    CacheFileStr fext;
+    CacheFileStr dname;
+    CacheFileStr uniqueid;
+    CacheFileStr guid;
+    CacheFileStr filecachename;
+    CacheFileStr description;
+    CacheFileStr tags;
+    CacheFileStr filehash;
+    int64_t      addtimestamp;
+    int64_t      filetime;
+    uint64_t     filesize;
+    int32_t      usagecounter;
+    int32_t      categoryid;
+    int32_t      version;
+    int32_t      fileformatversion;
+    int32_t      nodecount;
+    int32_t      beamcount;
+    int32_t      shockcount;
+    int32_t      fixescount;
+    int32_t      hydroscount;
+    int32_t      wheelcount;
+    int32_t      propwheelcount;
+    int32_t      commandscount;
+    int32_t      flarescount;
+    int32_t      propscount;
+    int32_t      wingscount;
+    int32_t      turbopropscount;
+    int32_t      turbojetcount;
+    int32_t      rotatorscount;
+    int32_t      exhaustscount;
+    int32_t      flexbodiescount;
+    int32_t      soundsourcescount;
+    float        truckmass;
+    float        loadmass;
+    float        minrpm;
+    float        maxrpm;
+    float        torque;
+    int32_t      driveable;
+    int32_t      numgears;
+    uint32_t     authors_start;
+    uint32_t     authors_count;
+    uint32_t     sectionconfigs_start;
+    uint32_t     sectionconfigs_count;
+    uint8_t      hasSubmeshs;
+    uint8_t      customtach;
+    uint8_t      custom_particles;
+    uint8_t      forwardcommands;
+    uint8_t      importcommands;
+    uint8_t      rescuer;
+    char         enginetype;
+    uint8_t      _padding;
+};
+
+/// Deduplicates strings - bundle paths, author names etc. are shared by many entries.
+class CacheFileStringTable
+{
+public:
+    CacheFileStr Add(std::string const& str)
+    {
+        auto itor = m_lookup.find(str);
+        if (itor != m_lookup.end())
+        {
+            return itor->second;
+        }
+
+        CacheFileStr rec;
+        rec.offset = static_cast<uint32_t>(m_buffer.size());
+        rec.length = static_cast<uint32_t>(str.size());
+        m_buffer.append(str);
+        m_lookup.insert(std::make_pair(str, rec));
+        return rec;
+    }
+
+    std::string const& GetBuffer() const { return m_buffer; }
+
+private:
+    std::string                                   m_buffer;
+    std::unordered_map<std::string, CacheFileStr> m_lookup;
+};
+
+/// Validates header and section sizes; outputs pointer to the string table.
+bool ReadCacheFileHeader(MappedFile const& file, CacheFileHeader& out_header, const char*& out_strings)
+{
+    if (file.GetSize() < sizeof(CacheFileHeader))
+    {
+        return false;
+    }
+
+    std::memcpy(&out_header, file.GetData(), sizeof(CacheFileHeader));
+    if (std::memcmp(out_header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    const uint64_t strings_offset = sizeof(CacheFileHeader)
+        + (uint64_t(out_header.num_entries)        * sizeof(CacheFileEntry))
+        + (uint64_t(out_header.num_authors)        * sizeof(CacheFileAuthor))
+        + (uint64_t(out_header.num_sectionconfigs) * sizeof(CacheFileStr));
+    if (strings_offset + out_header.strings_size != file.GetSize())
+    {
+        return false;
+    }
+
+    out_strings = file.GetData() + strings_offset;
+    return true;
+}
+
+std::string ReadCacheFileStr(CacheFileHeader const& header, const char* strings, CacheFileStr const& rec)
+{
+    if (uint64_t(rec.offset) + rec.length > header.strings_size)
+    {
+        return std::string();
+    }
+    return std::string(strings + rec.offset, rec.length);
+}
+
+} // namespace
+
 CacheEntry::CacheEntry() :
     addtimestamp(0),
     beamcount(0),
@@ -65,6 +231,7 @@ CacheEntry::CacheEntry() :
     enginetype('t'), // enginetype = t = truck is default
     exhaustscount(0),
     fileformatversion(0),
+    filesize(0),
     filetime(0),
     fixescount(0),
     flarescount(0),
@@ -115,6 +282,7 @@ CacheSystem::CacheSystem()
 void CacheSystem::LoadModCache(CacheValidityState validity)
 {
     m_resource_paths.clear();
+    m_content_hashes.clear();
     m_update_time = getTimeStamp();
 
     if (validity != CACHE_VALID)
@@ -134,10 +302,20 @@ void CacheSystem::LoadModCache(CacheValidityState validity)
         this->ParseKnownFiles(RGN_CONTENT);
         App::diag_log_console_echo->SetVal(App::diag_log_console_echo->GetBool());
         this->DetectDuplicates();
-        this->WriteCacheFileJson();
+        this->WriteCacheFileBinary();
+        this->PruneCompiledActorDefs();
+        if (App::app_export_cache_json->GetBool())
+        {
+            this->WriteCacheFileJson();
+        }
+    }
+
+    if (!this->LoadCacheFileBinary())
+    {
+        RoR::Log("[RoR|ModCache] Error, cache file still invalid after check/update, content selector will be empty.");
     }
 
-    this->LoadCacheFileJson();
+    this->BuildSearchIndex();
 
     RoR::Log("[RoR|ModCache] Cache loaded");
 }
@@ -145,30 +323,42 @@ void CacheSystem::LoadModCache(CacheValidityState validity)
 CacheEntry* CacheSystem::FindEntryByFilename(LoaderType type, bool partial, std::string filename)
 {
     StringUtil::toLowerCase(filename);
+
+    auto itor = m_filename_index.find(filename);
+    if (itor != m_filename_index.end())
+    {
+        for (uint32_t i : itor->second)
+        {
+            if ((type == LT_Terrain) == (m_entries[i].fext == "terrn2"))
+                return &m_entries[i];
+        }
+    }
+
+    if (!partial)
+        return nullptr;
+
+    std::vector<uint32_t> candidates;
+    const bool use_index = this->FindSearchCandidates(CacheSearchMethod::FILENAME, filename, candidates);
+    const size_t num_candidates = (use_index) ? candidates.size() : m_entries.size();
+
     size_t partial_match_length = std::numeric_limits<size_t>::max();
     CacheEntry* partial_match = nullptr;
-    for (CacheEntry& entry : m_entries)
+    for (size_t c = 0; c < num_candidates; ++c)
     {
-        if ((type == LT_Terrain) != (entry.fext == "terrn2"))
+        const uint32_t i = (use_index) ? candidates[c] : static_cast<uint32_t>(c);
+        if ((type == LT_Terrain) != (m_entries[i].fext == "terrn2"))
             continue;
 
-        String fname = entry.fname;
-        String fname_without_uid = entry.fname_without_uid;
-        StringUtil::toLowerCase(fname);
-        StringUtil::toLowerCase(fname_without_uid);
-        if (fname == filename || fname_without_uid == filename)
-            return &entry;
-
-        if (partial &&
-            fname.length() < partial_match_length &&
+        std::string const& fname = m_search_fields[i].fname;
+        if (fname.length() < partial_match_length &&
             fname.find(filename) != std::string::npos)
         {
-            partial_match = &entry;
+            partial_match = &m_entries[i];
             partial_match_length = fname.length();
         }
     }
 
-    return (partial) ? partial_match : nullptr;
+    return partial_match;
 }
 
 CacheSystem::CacheValidityState CacheSystem::EvaluateCacheValidity()
@@ -176,20 +366,23 @@ CacheSystem::CacheValidityState CacheSystem::EvaluateCacheValidity()
     this->GenerateHashFromFilenames();
 
     // First, open cache file and get hash for quick update check
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc))
+    MappedFile file;
+    CacheFileHeader header;
+    const char* strings = nullptr;
+    if (!file.Open(PathCombine(App::sys_cache_dir->GetStr(), CACHE_FILE)) ||
+        !ReadCacheFileHeader(file, header, strings))
     {
         RoR::Log("[RoR|ModCache] Invalid or missing cache file");
         return CACHE_NEEDS_REBUILD;
     }
 
-    if (j_doc["format_version"].GetInt() != CACHE_FILE_FORMAT)
+    if (header.format_version != CACHE_FILE_FORMAT)
     {
         RoR::Log("[RoR|ModCache] Invalid cache file format");
         return CACHE_NEEDS_REBUILD;
     }
 
-    if (j_doc["global_hash"].GetString() != m_filenames_hash)
+    if (ReadCacheFileStr(header, strings, header.global_hash) != m_filenames_hash)
     {
         RoR::Log("[RoR|ModCache] Cache file out of date");
         return CACHE_NEEDS_UPDATE;
@@ -199,208 +392,454 @@ CacheSystem::CacheValidityState CacheSystem::EvaluateCacheValidity()
     return CACHE_VALID;
 }
 
-void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & out_entry)
+bool CacheSystem::LoadCacheFileBinary()
 {
-    // Common details
-    out_entry.usagecounter =           j_entry["usagecounter"].GetInt();
-    out_entry.addtimestamp =           j_entry["addtimestamp"].GetInt();
-    out_entry.resource_bundle_type =   j_entry["resource_bundle_type"].GetString();
-    out_entry.resource_bundle_path =   j_entry["resource_bundle_path"].GetString();
-    out_entry.fpath =                  j_entry["fpath"].GetString();
-    out_entry.fname =                  j_entry["fname"].GetString();
-    out_entry.fname_without_uid =      j_entry["fname_without_uid"].GetString();
-    out_entry.fext =                   j_entry["fext"].GetString();
-    out_entry.filetime =               j_entry["filetime"].GetInt();
-    out_entry.dname =                  j_entry["dname"].GetString();
-    out_entry.uniqueid =               j_entry["uniqueid"].GetString();
-    out_entry.version =                j_entry["version"].GetInt();
-    out_entry.filecachename =          j_entry["filecachename"].GetString();
-
-    out_entry.guid = j_entry["guid"].GetString();
-    Ogre::StringUtil::trim(out_entry.guid);
-
-    // Category
-    int category_id = j_entry["categoryid"].GetInt();
-    auto category_itor = m_categories.find(category_id);
-    if (category_itor == m_categories.end() || category_id >= CID_Max)
-    {
-        category_itor = m_categories.find(CID_Unsorted);
-    }
-    out_entry.categoryname = category_itor->second;
-    out_entry.categoryid = category_itor->first;
-
-     // Common - Authors
-    for (rapidjson::Value& j_author: j_entry["authors"].GetArray())
-    {
-        AuthorInfo author;
-
-        author.type  =  j_author["type"].GetString();
-        author.name  =  j_author["name"].GetString();
-        author.email =  j_author["email"].GetString();
-        author.id    =  j_author["id"].GetInt();
+    // Clear existing entries
+    m_entries.clear();
 
-        out_entry.authors.push_back(author);
+    MappedFile file;
+    CacheFileHeader header;
+    const char* strings = nullptr;
+    if (!file.Open(PathCombine(App::sys_cache_dir->GetStr(), CACHE_FILE)) ||
+        !ReadCacheFileHeader(file, header, strings) ||
+        header.format_version != CACHE_FILE_FORMAT)
+    {
+        return false;
     }
 
-    // Vehicle details
-    out_entry.description =       j_entry["description"].GetString();
-    out_entry.tags =              j_entry["tags"].GetString();
-    out_entry.fileformatversion = j_entry["fileformatversion"].GetInt();
-    out_entry.hasSubmeshs =       j_entry["hasSubmeshs"].GetBool();
-    out_entry.nodecount =         j_entry["nodecount"].GetInt();
-    out_entry.beamcount =         j_entry["beamcount"].GetInt();
-    out_entry.shockcount =        j_entry["shockcount"].GetInt();
-    out_entry.fixescount =        j_entry["fixescount"].GetInt();
-    out_entry.hydroscount =       j_entry["hydroscount"].GetInt();
-    out_entry.wheelcount =        j_entry["wheelcount"].GetInt();
-    out_entry.propwheelcount =    j_entry["propwheelcount"].GetInt();
-    out_entry.commandscount =     j_entry["commandscount"].GetInt();
-    out_entry.flarescount =       j_entry["flarescount"].GetInt();
-    out_entry.propscount =        j_entry["propscount"].GetInt();
-    out_entry.wingscount =        j_entry["wingscount"].GetInt();
-    out_entry.turbopropscount =   j_entry["turbopropscount"].GetInt();
-    out_entry.turbojetcount =     j_entry["turbojetcount"].GetInt();
-    out_entry.rotatorscount =     j_entry["rotatorscount"].GetInt();
-    out_entry.exhaustscount =     j_entry["exhaustscount"].GetInt();
-    out_entry.flexbodiescount =   j_entry["flexbodiescount"].GetInt();
-    out_entry.soundsourcescount = j_entry["soundsourcescount"].GetInt();
-    out_entry.truckmass =         j_entry["truckmass"].GetFloat();
-    out_entry.loadmass =          j_entry["loadmass"].GetFloat();
-    out_entry.minrpm =            j_entry["minrpm"].GetFloat();
-    out_entry.maxrpm =            j_entry["maxrpm"].GetFloat();
-    out_entry.torque =            j_entry["torque"].GetFloat();
-    out_entry.customtach =        j_entry["customtach"].GetBool();
-    out_entry.custom_particles =  j_entry["custom_particles"].GetBool();
-    out_entry.forwardcommands =   j_entry["forwardcommands"].GetBool();
-    out_entry.importcommands =    j_entry["importcommands"].GetBool();
-    out_entry.rescuer =           j_entry["rescuer"].GetBool();
-    out_entry.driveable =         ActorType(j_entry["driveable"].GetInt());
-    out_entry.numgears =          j_entry["numgears"].GetInt();
-    out_entry.enginetype =        static_cast<char>(j_entry["enginetype"].GetInt());
+    const char* entries_data = file.GetData() + sizeof(CacheFileHeader);
+    const char* authors_data = entries_data + (header.num_entries * sizeof(CacheFileEntry));
+    const char* sectionconfigs_data = authors_data + (header.num_authors * sizeof(CacheFileAuthor));
 
-    // Vehicle 'section-configs' (aka Modules in RigDef namespace)
-    for (rapidjson::Value& j_module_name: j_entry["sectionconfigs"].GetArray())
+    m_entries.reserve(header.num_entries);
+    for (uint32_t i = 0; i < header.num_entries; ++i)
     {
-        out_entry.sectionconfigs.push_back(j_module_name.GetString());
+        CacheFileEntry rec;
+        std::memcpy(&rec, entries_data + (i * sizeof(CacheFileEntry)), sizeof(CacheFileEntry));
+        if (rec.authors_start + rec.authors_count > header.num_authors ||
+            rec.sectionconfigs_start + rec.sectionconfigs_count > header.num_sectionconfigs)
+        {
+            RoR::Log("[RoR|ModCache] Corrupted entry in cache file, discarding it.");
+            m_entries.clear();
+            return false;
+        }
+
+        CacheEntry entry;
+
+        // Common details
+        entry.usagecounter =           rec.usagecounter;
+        entry.addtimestamp =           static_cast<std::time_t>(rec.addtimestamp);
+        entry.resource_bundle_type =   ReadCacheFileStr(header, strings, rec.resource_bundle_type);
+        entry.resource_bundle_path =   ReadCacheFileStr(header, strings, rec.resource_bundle_path);
+        entry.fpath =                  ReadCacheFileStr(header, strings, rec.fpath);
+        entry.fname =                  ReadCacheFileStr(header, strings, rec.fname);
+        entry.fname_without_uid =      ReadCacheFileStr(header, strings, rec.fname_without_uid);
+        entry.fext =                   ReadCacheFileStr(header, strings, rec.fext);
+        entry.filetime =               static_cast<std::time_t>(rec.filetime);
+        entry.filesize =               rec.filesize;
+        entry.filehash =               ReadCacheFileStr(header, strings, rec.filehash);
+        entry.dname =                  ReadCacheFileStr(header, strings, rec.dname);
+        entry.uniqueid =               ReadCacheFileStr(header, strings, rec.uniqueid);
+        entry.version =                rec.version;
+        entry.filecachename =          ReadCacheFileStr(header, strings, rec.filecachename);
+
+        entry.guid = ReadCacheFileStr(header, strings, rec.guid);
+        Ogre::StringUtil::trim(entry.guid);
+
+        // Category
+        auto category_itor = m_categories.find(rec.categoryid);
+        if (category_itor == m_categories.end() || rec.categoryid >= CID_Max)
+        {
+            category_itor = m_categories.find(CID_Unsorted);
+        }
+        entry.categoryname = category_itor->second;
+        entry.categoryid = category_itor->first;
+
+        // Common - Authors
+        entry.authors.reserve(rec.authors_count);
+        for (uint32_t j = rec.authors_start; j < rec.authors_start + rec.authors_count; ++j)
+        {
+            CacheFileAuthor a_rec;
+            std::memcpy(&a_rec, authors_data + (j * sizeof(CacheFileAuthor)), sizeof(CacheFileAuthor));
+
+            AuthorInfo author;
+            author.type  = ReadCacheFileStr(header, strings, a_rec.type);
+            author.name  = ReadCacheFileStr(header, strings, a_rec.name);
+            author.email = ReadCacheFileStr(header, strings, a_rec.email);
+            author.id    = a_rec.id;
+
+            entry.authors.push_back(author);
+        }
+
+        // Vehicle details
+        entry.description =       ReadCacheFileStr(header, strings, rec.description);
+        entry.tags =              ReadCacheFileStr(header, strings, rec.tags);
+        entry.fileformatversion = rec.fileformatversion;
+        entry.hasSubmeshs =       rec.hasSubmeshs != 0;
+        entry.nodecount =         rec.nodecount;
+        entry.beamcount =         rec.beamcount;
+        entry.shockcount =        rec.shockcount;
+        entry.fixescount =        rec.fixescount;
+        entry.hydroscount =       rec.hydroscount;
+        entry.wheelcount =        rec.wheelcount;
+        entry.propwheelcount =    rec.propwheelcount;
+        entry.commandscount =     rec.commandscount;
+        entry.flarescount =       rec.flarescount;
+        entry.propscount =        rec.propscount;
+        entry.wingscount =        rec.wingscount;
+        entry.turbopropscount =   rec.turbopropscount;
+        entry.turbojetcount =     rec.turbojetcount;
+        entry.rotatorscount =     rec.rotatorscount;
+        entry.exhaustscount =     rec.exhaustscount;
+        entry.flexbodiescount =   rec.flexbodiescount;
+        entry.soundsourcescount = rec.soundsourcescount;
+        entry.truckmass =         rec.truckmass;
+        entry.loadmass =          rec.loadmass;
+        entry.minrpm =            rec.minrpm;
+        entry.maxrpm =            rec.maxrpm;
+        entry.torque =            rec.torque;
+        entry.customtach =        rec.customtach != 0;
+        entry.custom_particles =  rec.custom_particles != 0;
+        entry.forwardcommands =   rec.forwardcommands != 0;
+        entry.importcommands =    rec.importcommands != 0;
+        entry.rescuer =           rec.rescuer != 0;
+        entry.driveable =         ActorType(rec.driveable);
+        entry.numgears =          rec.numgears;
+        entry.enginetype =        rec.enginetype;
+
+        // Vehicle 'section-configs' (aka Modules in RigDef namespace)
+        entry.sectionconfigs.reserve(rec.sectionconfigs_count);
+        for (uint32_t j = rec.sectionconfigs_start; j < rec.sectionconfigs_start + rec.sectionconfigs_count; ++j)
+        {
+            CacheFileStr s_rec;
+            std::memcpy(&s_rec, sectionconfigs_data + (j * sizeof(CacheFileStr)), sizeof(CacheFileStr));
+            entry.sectionconfigs.push_back(ReadCacheFileStr(header, strings, s_rec));
+        }
+
+        entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
+        m_entries.push_back(entry);
     }
+
+    return true;
 }
 
-void CacheSystem::LoadCacheFileJson()
+void CacheSystem::WriteCacheFileBinary()
 {
-    // Clear existing entries
-    m_entries.clear();
+    CacheFileStringTable strings;
+    std::vector<CacheFileEntry> entries;
+    std::vector<CacheFileAuthor> authors;
+    std::vector<CacheFileStr> sectionconfigs;
 
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc) ||
-        !j_doc.IsObject() || !j_doc.HasMember("entries") || !j_doc["entries"].IsArray())
+    for (CacheEntry const& entry : m_entries)
     {
-        RoR::Log("[RoR|ModCache] Error, cache file still invalid after check/update, content selector will be empty.");
-        return;
+        if (entry.deleted)
+        {
+            continue;
+        }
+
+        CacheFileEntry rec;
+        std::memset(&rec, 0, sizeof(CacheFileEntry));
+
+        // Common details
+        rec.usagecounter =           entry.usagecounter;
+        rec.addtimestamp =           static_cast<int64_t>(entry.addtimestamp);
+        rec.resource_bundle_type =   strings.Add(entry.resource_bundle_type);
+        rec.resource_bundle_path =   strings.Add(entry.resource_bundle_path);
+        rec.fpath =                  strings.Add(entry.fpath);
+        rec.fname =                  strings.Add(entry.fname);
+        rec.fname_without_uid =      strings.Add(entry.fname_without_uid);
+        rec.fext =                   strings.Add(entry.fext);
+        rec.filetime =               static_cast<int64_t>(entry.filetime);
+        rec.filesize =               entry.filesize;
+        rec.filehash =               strings.Add(entry.filehash);
+        rec.dname =                  strings.Add(entry.dname);
+        rec.categoryid =             entry.categoryid;
+        rec.uniqueid =               strings.Add(entry.uniqueid);
+        rec.guid =                   strings.Add(entry.guid);
+        rec.version =                entry.version;
+        rec.filecachename =          strings.Add(entry.filecachename);
+
+        // Common - Authors
+        rec.authors_start = static_cast<uint32_t>(authors.size());
+        rec.authors_count = static_cast<uint32_t>(entry.authors.size());
+        for (AuthorInfo const& author: entry.authors)
+        {
+            CacheFileAuthor a_rec;
+            a_rec.type  = strings.Add(author.type);
+            a_rec.name  = strings.Add(author.name);
+            a_rec.email = strings.Add(author.email);
+            a_rec.id    = author.id;
+            authors.push_back(a_rec);
+        }
+
+        // Vehicle details
+        rec.description =       strings.Add(entry.description);
+        rec.tags =              strings.Add(entry.tags);
+        rec.fileformatversion = entry.fileformatversion;
+        rec.hasSubmeshs =       entry.hasSubmeshs;
+        rec.nodecount =         entry.nodecount;
+        rec.beamcount =         entry.beamcount;
+        rec.shockcount =        entry.shockcount;
+        rec.fixescount =        entry.fixescount;
+        rec.hydroscount =       entry.hydroscount;
+        rec.wheelcount =        entry.wheelcount;
+        rec.propwheelcount =    entry.propwheelcount;
+        rec.commandscount =     entry.commandscount;
+        rec.flarescount =       entry.flarescount;
+        rec.propscount =        entry.propscount;
+        rec.wingscount =        entry.wingscount;
+        rec.turbopropscount =   entry.turbopropscount;
+        rec.turbojetcount =     entry.turbojetcount;
+        rec.rotatorscount =     entry.rotatorscount;
+        rec.exhaustscount =     entry.exhaustscount;
+        rec.flexbodiescount =   entry.flexbodiescount;
+        rec.soundsourcescount = entry.soundsourcescount;
+        rec.truckmass =         entry.truckmass;
+        rec.loadmass =          entry.loadmass;
+        rec.minrpm =            entry.minrpm;
+        rec.maxrpm =            entry.maxrpm;
+        rec.torque =            entry.torque;
+        rec.customtach =        entry.customtach;
+        rec.custom_particles =  entry.custom_particles;
+        rec.forwardcommands =   entry.forwardcommands;
+        rec.importcommands =    entry.importcommands;
+        rec.rescuer =           entry.rescuer;
+        rec.driveable =         static_cast<int32_t>(entry.driveable);
+        rec.numgears =          entry.numgears;
+        rec.enginetype =        entry.enginetype;
+
+        // Vehicle 'section-configs' (aka Modules in RigDef namespace)
+        rec.sectionconfigs_start = static_cast<uint32_t>(sectionconfigs.size());
+        rec.sectionconfigs_count = static_cast<uint32_t>(entry.sectionconfigs.size());
+        for (std::string const & module_name: entry.sectionconfigs)
+        {
+            sectionconfigs.push_back(strings.Add(module_name));
+        }
+
+        entries.push_back(rec);
     }
 
-    for (rapidjson::Value& j_entry: j_doc["entries"].GetArray())
+    CacheFileHeader header;
+    std::memset(&header, 0, sizeof(CacheFileHeader));
+    std::memcpy(header.magic, CACHE_FILE_MAGIC, sizeof(header.magic));
+    header.format_version     = CACHE_FILE_FORMAT;
+    header.num_entries        = static_cast<uint32_t>(entries.size());
+    header.num_authors        = static_cast<uint32_t>(authors.size());
+    header.num_sectionconfigs = static_cast<uint32_t>(sectionconfigs.size());
+    header.global_hash        = strings.Add(m_filenames_hash);
+    header.strings_size       = static_cast<uint32_t>(strings.GetBuffer().size());
+
+    // Write to file
+    try
     {
-        CacheEntry entry;
-        this->ImportEntryFromJson(j_entry, entry);
-        entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
-        m_entries.push_back(entry);
+        Ogre::DataStreamPtr stream = ResourceGroupManager::getSingleton().createResource(CACHE_FILE, RGN_CACHE, /*overwrite=*/true);
+        stream->write(&header, sizeof(CacheFileHeader));
+        stream->write(entries.data(), entries.size() * sizeof(CacheFileEntry));
+        stream->write(authors.data(), authors.size() * sizeof(CacheFileAuthor));
+        stream->write(sectionconfigs.data(), sectionconfigs.size() * sizeof(CacheFileStr));
+        stream->write(strings.GetBuffer().data(), strings.GetBuffer().size());
+        RoR::LogFormat("[RoR|ModCache] File '%s' written OK", CACHE_FILE);
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error writing file '%s', message: '%s'", CACHE_FILE, e.what());
     }
 }
 
 void CacheSystem::PruneCache()
 {
-    this->LoadCacheFileJson();
+    this->LoadCacheFileBinary();
 
-    std::vector<String> paths;
+    // Each bundle is checked once, even if it contains many entries
+    std::map<String, std::pair<bool, std::time_t>> checked_paths; // path => (valid, filetime)
     for (auto& entry : m_entries)
     {
-        std::string fn = entry.resource_bundle_path;
-        if (entry.resource_bundle_type == "FileSystem")
+        std::string fn = CacheSystem::GetFingerprintPath(entry);
+        auto itor = checked_paths.find(fn);
+        if (itor == checked_paths.end())
         {
-            fn = PathCombine(fn, entry.fname);
+            std::time_t filetime = entry.filetime;
+            bool valid = this->CheckFingerprint(entry, fn, filetime);
+            if (!valid)
+            {
+                RoR::LogFormat("[RoR|ModCache] Removing '%s'", fn.c_str());
+            }
+            itor = checked_paths.insert(std::make_pair(fn, std::make_pair(valid, filetime))).first;
         }
 
-        if (!RoR::FileExists(fn.c_str()) || (entry.filetime != RoR::GetFileLastModifiedTime(fn)))
+        if (!itor->second.first)
         {
             if (!entry.deleted)
             {
-                if (std::find(paths.begin(), paths.end(), fn) == paths.end())
-                {
-                    RoR::LogFormat("[RoR|ModCache] Removing '%s'", fn.c_str());
-                    paths.push_back(fn);
-                }
                 this->RemoveFileCache(entry);
             }
             entry.deleted = true;
         }
         else
         {
+            entry.filetime = itor->second.second; // Content unchanged, but the file may have been touched
             m_resource_paths.insert(fn);
         }
     }
 }
 
+std::string CacheSystem::GetFingerprintPath(CacheEntry const& entry)
+{
+    if (entry.resource_bundle_type == "FileSystem")
+    {
+        return PathCombine(entry.resource_bundle_path, entry.fname);
+    }
+    return entry.resource_bundle_path;
+}
+
+std::string CacheSystem::GetCompiledActorDefFilename(CacheEntry const& entry)
+{
+    const std::string key = entry.resource_bundle_path + "|" + entry.fname;
+    return "actordef_" + HashData(key.c_str(), static_cast<int>(key.size())) + ".bin";
+}
+
+void CacheSystem::PruneCompiledActorDefs()
+{
+    std::set<std::string> valid_filenames;
+    for (CacheEntry const& entry : m_entries)
+    {
+        if (!entry.deleted)
+        {
+            valid_filenames.insert(CacheSystem::GetCompiledActorDefFilename(entry));
+        }
+    }
+
+    try
+    {
+        Ogre::StringVectorPtr filenames = Ogre::ResourceGroupManager::getSingleton().findResourceNames(RGN_CACHE, "actordef_*.bin");
+        for (std::string const& filename : *filenames)
+        {
+            if (valid_filenames.find(filename) == valid_filenames.end())
+            {
+                App::GetContentManager()->DeleteDiskFile(filename, RGN_CACHE);
+            }
+        }
+    }
+    catch (Ogre::Exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error pruning compiled actor definitions, message: %s", e.getFullDescription().c_str());
+    }
+}
+
+bool CacheSystem::CheckFingerprint(CacheEntry const& entry, std::string const& path, std::time_t& out_filetime)
+{
+    uint64_t size = 0;
+    std::time_t filetime = 0;
+    if (!RoR::GetFileSizeAndTime(path, size, filetime) || size != entry.filesize)
+    {
+        return false;
+    }
+
+    if (filetime == entry.filetime)
+    {
+        return true; // Fast path - no need to read the file
+    }
+
+    // Modification time differs (i.e. the file was re-synced) - compare contents if we can
+    if (!entry.filehash.empty() && this->ComputeContentHash(path) == entry.filehash)
+    {
+        out_filetime = filetime;
+        return true;
+    }
+
+    return false;
+}
+
+std::string CacheSystem::ComputeContentHash(std::string const& path)
+{
+    auto itor = m_content_hashes.find(path);
+    if (itor != m_content_hashes.end())
+    {
+        return itor->second;
+    }
+
+    std::string hash;
+    MappedFile file;
+    if (file.Open(path) && file.GetSize() <= static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        hash = HashData(file.GetData(), static_cast<int>(file.GetSize()));
+    }
+    m_content_hashes.insert(std::make_pair(path, hash));
+    return hash;
+}
+
 void CacheSystem::DetectDuplicates()
 {
     RoR::Log("[RoR|ModCache] Searching for duplicates ...");
-    std::map<String, String> possible_duplicates;
-    for (int i=0; i<m_entries.size(); i++) 
+
+    // Only entries with equal filename (without UID), display name and bundle name can be duplicates,
+    // so group them by these (normalized once per entry) and only compare within groups.
+    std::unordered_map<String, std::vector<size_t>> groups;
+    for (size_t i = 0; i < m_entries.size(); i++)
     {
         if (m_entries[i].deleted)
             continue;
 
-        String dnameA = m_entries[i].dname;
-        StringUtil::toLowerCase(dnameA);
-        StringUtil::trim(dnameA);
-        String dirA = m_entries[i].resource_bundle_path;
-        StringUtil::toLowerCase(dirA);
-        String basenameA, basepathA;
-        StringUtil::splitFilename(dirA, basenameA, basepathA);
-        String filenameWUIDA = m_entries[i].fname_without_uid;
-        StringUtil::toLowerCase(filenameWUIDA);
-
-        for (int j=i+1; j<m_entries.size(); j++) 
-        {
-            if (m_entries[j].deleted)
-                continue;
-
-            String filenameWUIDB = m_entries[j].fname_without_uid;
-            StringUtil::toLowerCase(filenameWUIDB);
-            if (filenameWUIDA != filenameWUIDB)
-                continue;
-
-            String dnameB = m_entries[j].dname;
-            StringUtil::toLowerCase(dnameB);
-            StringUtil::trim(dnameB);
-            if (dnameA != dnameB)
-                continue;
+        String dname = m_entries[i].dname;
+        StringUtil::toLowerCase(dname);
+        StringUtil::trim(dname);
+        String dir = m_entries[i].resource_bundle_path;
+        StringUtil::toLowerCase(dir);
+        String basename, basepath;
+        StringUtil::splitFilename(dir, basename, basepath);
+        basename = Ogre::StringUtil::replaceAll(basename, " ", "_");
+        basename = Ogre::StringUtil::replaceAll(basename, "-", "_");
+        String filenameWUID = m_entries[i].fname_without_uid;
+        StringUtil::toLowerCase(filenameWUID);
+
+        String key = filenameWUID;
+        key += '\0';
+        key += dname;
+        key += '\0';
+        key += StripSHA1fromString(basename);
+        groups[key].push_back(i);
+    }
 
-            String dirB = m_entries[j].resource_bundle_path;
-            StringUtil::toLowerCase(dirB);
-            String basenameB, basepathB;
-            StringUtil::splitFilename(dirB, basenameB, basepathB);
-            basenameA = Ogre::StringUtil::replaceAll(basenameA, " ", "_");
-            basenameA = Ogre::StringUtil::replaceAll(basenameA, "-", "_");
-            basenameB = Ogre::StringUtil::replaceAll(basenameB, " ", "_");
-            basenameB = Ogre::StringUtil::replaceAll(basenameB, "-", "_");
-            if (StripSHA1fromString(basenameA) != StripSHA1fromString(basenameB))
+    std::vector<std::pair<size_t, size_t>> possible_duplicates;
+    for (auto& group : groups)
+    {
+        std::vector<size_t> const& members = group.second;
+        for (size_t a = 0; a < members.size(); a++)
+        {
+            const size_t i = members[a];
+            if (m_entries[i].deleted)
                 continue;
 
-            if (m_entries[i].resource_bundle_path == m_entries[j].resource_bundle_path)
-            {
-                LOG("- duplicate: " + m_entries[i].fpath + m_entries[i].fname
-                             + " <--> " + m_entries[j].fpath + m_entries[j].fname);
-                LOG("  - " + m_entries[j].resource_bundle_path);
-                int idx = m_entries[i].fpath.size() < m_entries[j].fpath.size() ? i : j;
-                m_entries[idx].deleted = true;
-            }
-            else
+            for (size_t b = a + 1; b < members.size(); b++)
             {
-                possible_duplicates[m_entries[i].resource_bundle_path] = m_entries[j].resource_bundle_path;
+                const size_t j = members[b];
+                if (m_entries[j].deleted)
+                    continue;
+
+                if (m_entries[i].resource_bundle_path == m_entries[j].resource_bundle_path)
+                {
+                    LOG("- duplicate: " + m_entries[i].fpath + m_entries[i].fname
+                                 + " <--> " + m_entries[j].fpath + m_entries[j].fname);
+                    LOG("  - " + m_entries[j].resource_bundle_path);
+                    size_t idx = m_entries[i].fpath.size() < m_entries[j].fpath.size() ? i : j;
+                    m_entries[idx].deleted = true;
+                }
+                else
+                {
+                    possible_duplicates.push_back(std::make_pair(i, j));
+                }
             }
         }
     }
-    for (auto duplicate : possible_duplicates)
+
+    // Report in the order of the entries
+    std::sort(possible_duplicates.begin(), possible_duplicates.end());
+    std::map<String, String> possible_duplicate_paths;
+    for (auto const& pair : possible_duplicates)
+    {
+        possible_duplicate_paths[m_entries[pair.first].resource_bundle_path] = m_entries[pair.second].resource_bundle_path;
+    }
+    for (auto duplicate : possible_duplicate_paths)
     {
         LOG("- possible duplicate: ");
         LOG("  - " + duplicate.first);
@@ -442,6 +881,8 @@ void CacheSystem::ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Docu
     j_entry.AddMember("fname_without_uid",    rapidjson::StringRef(entry.fname_without_uid.c_str()),       j_doc.GetAllocator());
     j_entry.AddMember("fext",                 rapidjson::StringRef(entry.fext.c_str()),                    j_doc.GetAllocator());
     j_entry.AddMember("filetime",             static_cast<int64_t>(entry.filetime),                        j_doc.GetAllocator()); 
+    j_entry.AddMember("filesize",             entry.filesize,                                              j_doc.GetAllocator());
+    j_entry.AddMember("filehash",             rapidjson::StringRef(entry.filehash.c_str()),                j_doc.GetAllocator());
     j_entry.AddMember("dname",                rapidjson::StringRef(entry.dname.c_str()),                   j_doc.GetAllocator());
     j_entry.AddMember("categoryid",           entry.categoryid,                                            j_doc.GetAllocator());
     j_entry.AddMember("uniqueid",             rapidjson::StringRef(entry.uniqueid.c_str()),                j_doc.GetAllocator());
@@ -532,9 +973,9 @@ void CacheSystem::WriteCacheFileJson()
     j_doc.AddMember("entries", j_entries, j_doc.GetAllocator());
 
     // Write to file
-    if (App::GetContentManager()->SerializeAndWriteJson(CACHE_FILE, RGN_CACHE, j_doc)) // Logs errors
+    if (App::GetContentManager()->SerializeAndWriteJson(CACHE_FILE_JSON, RGN_CACHE, j_doc)) // Logs errors
     {
-        RoR::LogFormat("[RoR|ModCache] File '%s' written OK", CACHE_FILE);
+        RoR::LogFormat("[RoR|ModCache] File '%s' written OK", CACHE_FILE_JSON);
     }
 }
 
@@ -575,6 +1016,10 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
     String type = f.archive ? f.archive->getType() : "FileSystem";
     String path = f.archive ? f.archive->getName() : "";
 
+    // Unmodified loose files were already confirmed by `PruneCache()`
+    if (type == "FileSystem" && m_resource_paths.find(PathCombine(path, f.filename)) != m_resource_paths.end())
+        return;
+
     if (std::find_if(m_entries.begin(), m_entries.end(), [&](CacheEntry& e)
                 { return !e.deleted && e.fname == f.filename && e.resource_bundle_path == path; }) != m_entries.end())
         return;
@@ -586,6 +1031,13 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
         DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(f.filename, group);
         // ds closes automatically, so do _not_ close it explicitly below
 
+        // Fingerprint of the file which decides if the entries need updating, see `PruneCache()`
+        const std::string fingerprint_path = (type == "Zip") ? path : PathCombine(path, f.filename);
+        uint64_t filesize = 0;
+        std::time_t filetime = 0;
+        RoR::GetFileSizeAndTime(fingerprint_path, filesize, filetime);
+        const std::string filehash = (App::app_cache_content_hash->GetBool()) ? this->ComputeContentHash(fingerprint_path) : "";
+
         std::vector<CacheEntry> new_entries;
         if (ext == "terrn2")
         {
@@ -628,14 +1080,9 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
             entry.fname = f.filename;
             entry.fname_without_uid = StripUIDfromString(f.filename);
             entry.fext = ext;
-            if (type == "Zip")
-            {
-                entry.filetime = RoR::GetFileLastModifiedTime(path);
-            }
-            else
-            {
-                entry.filetime = RoR::GetFileLastModifiedTime(PathCombine(path, f.filename));
-            }
+            entry.filetime = filetime;
+            entry.filesize = filesize;
+            entry.filehash = filehash;
             entry.resource_bundle_type = type;
             entry.resource_bundle_path = path;
             entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
@@ -1011,22 +1458,17 @@ bool CacheSystem::CheckResourceLoaded(Ogre::String & filename, Ogre::String& gro
             return true;
         }
 
-        for (auto& entry : m_entries)
+        // case insensitive comparison
+        StringUtil::toLowerCase(filename);
+        auto itor = m_filename_index.find(filename);
+        if (itor != m_filename_index.end())
         {
-            // case insensitive comparison
-            String fname = entry.fname;
-            String fname_without_uid = entry.fname_without_uid;
-            StringUtil::toLowerCase(fname);
-            StringUtil::toLowerCase(filename);
-            StringUtil::toLowerCase(fname_without_uid);
-            if (fname == filename || fname_without_uid == filename)
-            {
-                // we found the file, load it
-                LoadResource(entry);
-                filename = entry.fname;
-                group = entry.resource_group;
-                return !group.empty() && ResourceGroupManager::getSingleton().resourceExists(group, filename);
-            }
+            // we found the file, load it
+            CacheEntry& entry = m_entries[itor->second.front()];
+            LoadResource(entry);
+            filename = entry.fname;
+            group = entry.resource_group;
+            return !group.empty() && ResourceGroupManager::getSingleton().resourceExists(group, filename);
         }
     }
     catch (Ogre::Exception) {} // Already logged by OGRE
@@ -1166,13 +1608,26 @@ std::shared_ptr<SkinDef> CacheSystem::FetchSkinDef(CacheEntry* cache_entry)
 size_t CacheSystem::Query(CacheQuery& query)
 {
     Ogre::StringUtil::toLowerCase(query.cqy_search_string);
-    for (CacheEntry& entry: m_entries)
+
+    // Filter by GUID - only visit matching entries
+    static const std::vector<uint32_t> NO_ENTRIES;
+    std::vector<uint32_t> const* guid_matches = nullptr;
+    if (!query.cqy_filter_guid.empty())
     {
-        // Filter by GUID
-        if (!query.cqy_filter_guid.empty() && entry.guid != query.cqy_filter_guid)
-        {
-            continue;
-        }
+        auto itor = m_guid_index.find(query.cqy_filter_guid);
+        guid_matches = (itor != m_guid_index.end()) ? &itor->second : &NO_ENTRIES;
+    }
+
+    // Search - only test entries which contain all trigrams of the search string
+    std::vector<uint32_t> candidates;
+    const bool use_index = this->FindSearchCandidates(query.cqy_search_method, query.cqy_search_string, candidates);
+    size_t next_candidate = 0;
+
+    const size_t num_visits = (guid_matches) ? guid_matches->size() : m_entries.size();
+    for (size_t v = 0; v < num_visits; ++v)
+    {
+        const uint32_t i = (guid_matches) ? (*guid_matches)[v] : static_cast<uint32_t>(v);
+        CacheEntry& entry = m_entries[i];
 
         // Filter by entry type
         bool add = false;
@@ -1210,42 +1665,54 @@ size_t CacheSystem::Query(CacheQuery& query)
             continue;
         }
 
+        // Skip entries ruled out by the index; both lists are ascending
+        if (use_index)
+        {
+            while (next_candidate < candidates.size() && candidates[next_candidate] < i)
+            {
+                next_candidate++;
+            }
+            if (next_candidate == candidates.size() || candidates[next_candidate] != i)
+            {
+                continue;
+            }
+        }
+
         // Search
+        SearchFields const& fields = m_search_fields[i];
         size_t score = 0;
         bool match = false;
-        Str<100> wheels_str;
         switch (query.cqy_search_method)
         {
         case CacheSearchMethod::FULLTEXT:
-            if (match = this->Match(score, entry.dname,       query.cqy_search_string, 0))   { break; }
-            if (match = this->Match(score, entry.fname,       query.cqy_search_string, 100)) { break; }
-            if (match = this->Match(score, entry.description, query.cqy_search_string, 200)) { break; }
-            for (AuthorInfo const& author: entry.authors)
+            if (match = this->Match(score, fields.dname,       query.cqy_search_string, 0))   { break; }
+            if (match = this->Match(score, fields.fname,       query.cqy_search_string, 100)) { break; }
+            if (match = this->Match(score, fields.description, query.cqy_search_string, 200)) { break; }
+            for (auto const& author: fields.authors)
             {
-                if (match = this->Match(score, author.name,  query.cqy_search_string, 300)) { break; }
-                if (match = this->Match(score, author.email, query.cqy_search_string, 400)) { break; }
+                if (match = this->Match(score, author.first,  query.cqy_search_string, 300)) { break; }
+                if (match = this->Match(score, author.second, query.cqy_search_string, 400)) { break; }
             }
             break;
 
         case CacheSearchMethod::GUID:
-            match = this->Match(score, entry.guid, query.cqy_search_string, 0);
+            match = this->Match(score, fields.guid, query.cqy_search_string, 0);
             break;
 
         case CacheSearchMethod::AUTHORS:
-            for (AuthorInfo const& author: entry.authors)
+            for (auto const& author: fields.authors)
             {
-                if (match = this->Match(score, author.name,  query.cqy_search_string, 0)) { break; }
-                if (match = this->Match(score, author.email, query.cqy_search_string, 0)) { break; }
+                if (match = this->Match(score, author.first,  query.cqy_search_string, 0)) { break; }
+                if (match = this->Match(score, author.second, query.cqy_search_string, 0)) { break; }
             }
             break;
 
         case CacheSearchMethod::WHEELS:
-            wheels_str << entry.wheelcount << "x" << entry.propwheelcount;
-            match = this->Match(score, wheels_str.ToCStr(), query.cqy_search_string, 0);
+            match = this->Match(score, fields.wheels, query.cqy_search_string, 0);
             break;
 
         case CacheSearchMethod::FILENAME:
-            match = this->Match(score, entry.fname, query.cqy_search_string, 100);
+            match = this->Match(score, fields.fname, query.cqy_search_string, 100);
             break;
 
         default: // CacheSearchMethod::NONE
@@ -1264,9 +1731,8 @@ size_t CacheSystem::Query(CacheQuery& query)
     return query.cqy_results.size();
 }
 
-bool CacheSystem::Match(size_t& out_score, std::string data, std::string const& query, size_t score)
+bool CacheSystem::Match(size_t& out_score, std::string const& data, std::string const& query, size_t score)
 {
-    Ogre::StringUtil::toLowerCase(data);
     size_t pos = data.find(query);
     if (pos != std::string::npos)
     {
@@ -1279,6 +1745,121 @@ bool CacheSystem::Match(size_t& out_score, std::string data, std::string const&
     }
 }
 
+static uint32_t MakeTrigram(const char* str)
+{
+    return (uint32_t(uint8_t(str[0])) << 16) | (uint32_t(uint8_t(str[1])) << 8) | uint32_t(uint8_t(str[2]));
+}
+
+static void CollectTrigrams(std::vector<uint32_t>& out_trigrams, std::string const& str)
+{
+    for (size_t i = 0; i + 3 <= str.size(); ++i)
+    {
+        out_trigrams.push_back(MakeTrigram(&str[i]));
+    }
+}
+
+void CacheSystem::BuildSearchIndex()
+{
+    m_search_fields.clear();
+    m_filename_index.clear();
+    m_guid_index.clear();
+    m_trigram_index.clear();
+
+    m_search_fields.resize(m_entries.size());
+    std::vector<uint32_t> trigrams;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); ++i)
+    {
+        CacheEntry const& entry = m_entries[i];
+        SearchFields& fields = m_search_fields[i];
+
+        fields.dname = entry.dname;
+        fields.fname = entry.fname;
+        fields.description = entry.description;
+        fields.guid = entry.guid;
+        Ogre::StringUtil::toLowerCase(fields.dname);
+        Ogre::StringUtil::toLowerCase(fields.fname);
+        Ogre::StringUtil::toLowerCase(fields.description);
+        Ogre::StringUtil::toLowerCase(fields.guid);
+        for (AuthorInfo const& author: entry.authors)
+        {
+            fields.authors.push_back(std::make_pair(author.name, author.email));
+            Ogre::StringUtil::toLowerCase(fields.authors.back().first);
+            Ogre::StringUtil::toLowerCase(fields.authors.back().second);
+        }
+        Str<100> wheels_str;
+        wheels_str << entry.wheelcount << "x" << entry.propwheelcount;
+        fields.wheels = wheels_str.ToCStr();
+
+        // Exact lookups
+        String fname_without_uid = entry.fname_without_uid;
+        Ogre::StringUtil::toLowerCase(fname_without_uid);
+        m_filename_index[fields.fname].push_back(i);
+        if (fname_without_uid != fields.fname)
+        {
+            m_filename_index[fname_without_uid].push_back(i);
+        }
+        m_guid_index[entry.guid].push_back(i);
+
+        // Substring search
+        trigrams.clear();
+        CollectTrigrams(trigrams, fields.dname);
+        CollectTrigrams(trigrams, fields.fname);
+        CollectTrigrams(trigrams, fields.description);
+        CollectTrigrams(trigrams, fields.guid);
+        for (auto const& author: fields.authors)
+        {
+            CollectTrigrams(trigrams, author.first);
+            CollectTrigrams(trigrams, author.second);
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        for (uint32_t trigram: trigrams)
+        {
+            m_trigram_index[trigram].push_back(i);
+        }
+    }
+
+    RoR::LogFormat("[RoR|ModCache] Search index built: %u entries, %u trigrams",
+        static_cast<unsigned>(m_entries.size()), static_cast<unsigned>(m_trigram_index.size()));
+}
+
+bool CacheSystem::FindSearchCandidates(CacheSearchMethod method, std::string const& query, std::vector<uint32_t>& out_candidates)
+{
+    // The index covers text fields only, and needs at least one full trigram
+    if (method == CacheSearchMethod::NONE || method == CacheSearchMethod::WHEELS || query.size() < 3)
+    {
+        return false;
+    }
+
+    std::vector<uint32_t> trigrams;
+    CollectTrigrams(trigrams, query);
+    std::vector<std::vector<uint32_t> const*> lists;
+    for (uint32_t trigram: trigrams)
+    {
+        auto itor = m_trigram_index.find(trigram);
+        if (itor == m_trigram_index.end())
+        {
+            out_candidates.clear(); // Nothing can match
+            return true;
+        }
+        lists.push_back(&itor->second);
+    }
+
+    // Intersect, shortest lists first
+    std::sort(lists.begin(), lists.end(),
+        [](std::vector<uint32_t> const* a, std::vector<uint32_t> const* b) { return a->size() < b->size(); });
+    out_candidates = *lists[0];
+    std::vector<uint32_t> intersection;
+    for (size_t i = 1; i < lists.size() && !out_candidates.empty(); ++i)
+    {
+        intersection.clear();
+        std::set_intersection(out_candidates.begin(), out_candidates.end(),
+                              lists[i]->begin(), lists[i]->end(), std::back_inserter(intersection));
+        out_candidates.swap(intersection);
+    }
+    return true;
+}
+
 bool CacheQueryResult::operator<(CacheQueryResult const& other)
 {
     if (cqr_score == other.cqr_score)
@@ -34,9 +34,11 @@
 #include <Ogre.h>
 #include <rapidjson/document.h>
 #include <string>
+#include <unordered_map>
 
 #define CACHE_FILE "mods.cache"
-#define CACHE_FILE_FORMAT 11
+#define CACHE_FILE_JSON "mods.cache.json" //!< Human-readable export, written only if 'app_export_cache_json' is set.
+#define CACHE_FILE_FORMAT 13
 
 namespace RoR {
 
@@ -74,6 +76,8 @@ public:
     std::string resource_bundle_path;   //!< Path of ZIP or directory which contains the media. Shared between CacheEntries, loaded only once.
     int number;                         //!< Sequential number, assigned internally, used by Selector-GUI
     std::time_t filetime;               //!< filetime
+    uint64_t filesize;                  //!< Size of the ZIP, or of the definition file for 'FileSystem' bundles; part of the fingerprint.
+    std::string filehash;               //!< Content hash of the same file; empty unless 'app_cache_content_hash' is set.
     bool deleted;                       //!< is this mod deleted?
     int usagecounter;                   //!< how much it was used already
     std::vector<AuthorInfo> authors;    //!< authors
@@ -174,7 +178,8 @@ struct CacheQuery
 ///    RoR users usually have A LOT of content installed. Traversing it all on every game startup would be a pain.
 /// HOW IT WORKS:
 ///    For each recognized resource type (vehicle, terrain, skin...) an instance of 'CacheEntry' is created.
-///       These entries are persisted in file CACHE_FILE (see above)
+///       These entries are persisted in binary file CACHE_FILE (see above) which is memory-mapped on load.
+///       The file holds fixed-size records referencing a shared string table, so no parsing is needed.
 ///    Associated media live in a "resource bundle" (ZIP archive or subdirectory) in content directory (ROR_HOME/mods) and subdirectories.
 ///       If multiple CacheEntries share a bundle, the bundle is loaded only once. Each bundle has dedicated OGRE resource group.
 class CacheSystem : public ZeroedMemoryAllocator
@@ -212,12 +217,15 @@ public:
     CacheEntry *GetEntry(int modid);
     Ogre::String GetPrettyName(Ogre::String fname);
 
+    static std::string GetFingerprintPath(CacheEntry const& entry); //!< The ZIP, or the definition file for 'FileSystem' bundles.
+    static std::string GetCompiledActorDefFilename(CacheEntry const& entry); //!< Binary RigDef::File in the cache dir, see `ActorManager::FetchActorDef()`
+
 private:
 
-    void WriteCacheFileJson();
+    void WriteCacheFileBinary();
+    bool LoadCacheFileBinary(); //!< Returns false if the file is missing or invalid.
+    void WriteCacheFileJson(); //!< Export only, the game never reads it back.
     void ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Document& j_doc, CacheEntry const & entry);
-    void LoadCacheFileJson();
-    void ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & out_entry);
 
     static Ogre::String StripUIDfromString(Ogre::String uidstr); 
     static Ogre::String StripSHA1fromString(Ogre::String sha1str);
@@ -228,6 +236,10 @@ private:
 
     void ClearCache(); // removes                   all files from the cache
     void PruneCache(); // removes modified (or deleted) files from the cache
+    void PruneCompiledActorDefs(); // removes compiled actor definitions of mods which are no longer installed
+
+    bool CheckFingerprint(CacheEntry const& entry, std::string const& path, std::time_t& out_filetime); //!< Size+mtime fast path, content hash as fallback.
+    std::string ComputeContentHash(std::string const& path); //!< Memoized per update.
 
     void AddFile(Ogre::String group, Ogre::FileInfo f, Ogre::String ext);
 
@@ -241,13 +253,34 @@ private:
     void GenerateFileCache(CacheEntry &entry, Ogre::String group);
     void RemoveFileCache(CacheEntry &entry);
 
-    bool Match(size_t& out_score, std::string data, std::string const& query, size_t );
+    bool Match(size_t& out_score, std::string const& data, std::string const& query, size_t ); //!< Both strings must be lowercase.
+
+    // Search index, rebuilt by `LoadModCache()` and parallel to `m_entries`
+
+    struct SearchFields //!< Lowercase copies of searched fields, so queries don't convert on the fly.
+    {
+        std::string dname;
+        std::string fname;
+        std::string description;
+        std::string guid;
+        std::string wheels; //!< Formatted as `<wheelcount>x<propwheelcount>`
+        std::vector<std::pair<std::string, std::string>> authors; //!< Name, email
+    };
+
+    void BuildSearchIndex();
+    bool FindSearchCandidates(CacheSearchMethod method, std::string const& query, std::vector<uint32_t>& out_candidates); //!< Returns false if the index cannot narrow down the search.
+
+    std::vector<SearchFields>                               m_search_fields;
+    std::unordered_map<std::string, std::vector<uint32_t>> m_filename_index; //!< Lowercase filename (also without UID) => entry indices, ascending
+    std::unordered_map<std::string, std::vector<uint32_t>> m_guid_index;     //!< GUID => entry indices, ascending
+    std::unordered_map<uint32_t, std::vector<uint32_t>>    m_trigram_index;  //!< 3 lowercase chars of any searched field => entry indices, ascending
 
     std::time_t                          m_update_time;      //!< Ensures that all inserted files share the same timestamp
     std::string                          m_filenames_hash;   //!< stores hash over the content, for quick update detection
     std::vector<CacheEntry>              m_entries;
     std::vector<Ogre::String>            m_known_extensions; //!< the extensions we track in the cache system
     std::set<Ogre::String>               m_resource_paths;   //!< A temporary list of existing resource paths
+    std::map<std::string, std::string>   m_content_hashes;   //!< A temporary list of file hashes computed during update
     std::map<int, Ogre::String>          m_categories = {
             // these are the category numbers from the repository. do not modify them!
 
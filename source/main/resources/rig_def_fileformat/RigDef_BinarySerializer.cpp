@@ -0,0 +1,950 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Compiled (binary) form of RigDef::File, used to skip parsing on spawn.
+///
+/// Every struct is described once by an `Io()` function which is used for both writing and reading.
+/// Objects held by `std::shared_ptr` (i.e. beam/node defaults referenced by many elements)
+/// are written once and referenced by index afterwards, so the sharing survives the round trip.
+
+#include "RigDef_BinarySerializer.h"
+
+#include <cstring>
+#include <list>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace RigDef;
+
+const char* BinarySerializer::SIGNATURE = "RoR RigDef";
+
+namespace RigDef {
+namespace BinaryIO {
+
+// --------------------------------------------------------------------------------
+// Archives
+
+struct FileHeader
+{
+    char     signature[12];
+    uint32_t file_format_version;
+    uint32_t layout_check;   //!< Catches struct changes which didn't bump the version
+    uint64_t source_size;
+    int64_t  source_time;
+    uint64_t payload_size;   //!< Catches truncated files
+};
+
+/// Unique ID per type, used to validate shared objects on load.
+template<typename T> const void* GetTypeKey()
+{
+    static const char key = 0;
+    return &key;
+}
+
+class Writer
+{
+public:
+    static const bool IS_READING = false;
+
+    explicit Writer(std::vector<char>& buf): m_buf(buf) {}
+
+    template<typename T> void Pod(T& value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        m_buf.insert(m_buf.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Bytes(const char* data, size_t length)
+    {
+        m_buf.insert(m_buf.end(), data, data + length);
+    }
+
+    bool CheckCount(uint32_t) { return true; }
+
+    /// Returns true if the object is written for the first time.
+    bool AddSharedObject(const void* ptr, uint32_t& out_index)
+    {
+        auto result = m_shared_objects.insert(std::make_pair(ptr, static_cast<uint32_t>(m_shared_objects.size() + 1)));
+        out_index = result.first->second;
+        return result.second;
+    }
+
+private:
+    std::vector<char>&                        m_buf;
+    std::unordered_map<const void*, uint32_t> m_shared_objects; //!< Object => 1-based index
+};
+
+class Reader
+{
+public:
+    static const bool IS_READING = true;
+
+    Reader(const char* data, size_t length): m_pos(data), m_end(data + length), m_error(false) {}
+
+    template<typename T> void Pod(T& value)
+    {
+        if (static_cast<size_t>(m_end - m_pos) < sizeof(T))
+        {
+            this->SetError();
+            value = T();
+            return;
+        }
+        std::memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+    }
+
+    void Bytes(std::string& out, size_t length)
+    {
+        if (static_cast<size_t>(m_end - m_pos) < length)
+        {
+            this->SetError();
+            return;
+        }
+        out.assign(m_pos, length);
+        m_pos += length;
+    }
+
+    /// Every element takes at least 1 byte - guards against absurd allocations from damaged data.
+    bool CheckCount(uint32_t count)
+    {
+        if (static_cast<size_t>(m_end - m_pos) < count)
+        {
+            this->SetError();
+        }
+        return !m_error;
+    }
+
+    size_t GetNumSharedObjects() const { return m_shared_objects.size(); }
+
+    void AddSharedObject(std::shared_ptr<void> obj, const void* type_key)
+    {
+        m_shared_objects.push_back(std::make_pair(obj, type_key));
+    }
+
+    template<typename T> std::shared_ptr<T> GetSharedObject(uint32_t index)
+    {
+        auto& entry = m_shared_objects.at(index - 1);
+        if (entry.second != GetTypeKey<T>())
+        {
+            this->SetError();
+            return nullptr;
+        }
+        return std::static_pointer_cast<T>(entry.first);
+    }
+
+    void SetError()    { m_error = true; m_pos = m_end; }
+    bool HasError() const { return m_error; }
+    bool IsAtEnd() const  { return m_pos == m_end; }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+    bool        m_error;
+    std::vector<std::pair<std::shared_ptr<void>, const void*>> m_shared_objects; //!< 1-based index => (object, type key)
+};
+
+// --------------------------------------------------------------------------------
+// Construction of types without default constructor
+
+template<typename T> T MakeDefault() { return T(); }
+template<> Node::Range MakeDefault<Node::Range>() { return Node::Range(Node::Ref()); }
+
+template<typename T> T* MakeNew() { return new T(); }
+template<> File::Module* MakeNew<File::Module>() { return new File::Module(""); }
+
+// --------------------------------------------------------------------------------
+// Generic types
+// Note: All `Io()` overloads live in this namespace with the archives, so argument-dependent
+//       lookup finds them regardless of the order they're declared in.
+
+template<class AR> void IoAll(AR&) {}
+
+template<class AR, typename T, typename... Ts> void IoAll(AR& ar, T& first, Ts&... rest)
+{
+    Io(ar, first);
+    IoAll(ar, rest...);
+}
+
+template<class AR, typename T>
+typename std::enable_if<(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) || std::is_enum<T>::value>::type
+Io(AR& ar, T& value)
+{
+    ar.Pod(value);
+}
+
+template<class AR> void Io(AR& ar, bool& value)
+{
+    uint8_t byte = (value) ? 1 : 0;
+    ar.Pod(byte);
+    value = (byte != 0);
+}
+
+template<class AR, typename T, size_t N> void Io(AR& ar, T (&arr)[N])
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        Io(ar, arr[i]);
+    }
+}
+
+inline void Io(Writer& ar, std::string& str)
+{
+    uint32_t length = static_cast<uint32_t>(str.length());
+    ar.Pod(length);
+    ar.Bytes(str.data(), length);
+}
+
+inline void Io(Reader& ar, std::string& str)
+{
+    uint32_t length = 0;
+    ar.Pod(length);
+    ar.Bytes(str, length);
+}
+
+template<class AR> void Io(AR& ar, Ogre::Vector3& v)
+{
+    IoAll(ar, v.x, v.y, v.z);
+}
+
+template<class AR> void Io(AR& ar, Ogre::ColourValue& c)
+{
+    IoAll(ar, c.r, c.g, c.b, c.a);
+}
+
+template<class AR, typename CONTAINER> void IoSequence(AR& ar, CONTAINER& seq)
+{
+    uint32_t count = static_cast<uint32_t>(seq.size());
+    ar.Pod(count);
+    if (AR::IS_READING)
+    {
+        seq.clear();
+        if (!ar.CheckCount(count))
+        {
+            return;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            seq.push_back(MakeDefault<typename CONTAINER::value_type>());
+            Io(ar, seq.back());
+        }
+    }
+    else
+    {
+        for (auto& elem: seq)
+        {
+            Io(ar, elem);
+        }
+    }
+}
+
+template<class AR, typename T> void Io(AR& ar, std::vector<T>& vec)
+{
+    IoSequence(ar, vec);
+}
+
+template<class AR, typename T> void Io(AR& ar, std::list<T>& list)
+{
+    IoSequence(ar, list);
+}
+
+template<typename T> void Io(Writer& ar, std::shared_ptr<T>& ptr)
+{
+    uint32_t index = 0; // 0 = null
+    bool is_new = (ptr != nullptr) && ar.AddSharedObject(ptr.get(), index);
+    ar.Pod(index);
+    if (is_new)
+    {
+        Io(ar, *ptr);
+    }
+}
+
+template<typename T> void Io(Reader& ar, std::shared_ptr<T>& ptr)
+{
+    uint32_t index = 0;
+    ar.Pod(index);
+    ptr.reset();
+    if (index == 0)
+    {
+        return;
+    }
+    else if (index <= ar.GetNumSharedObjects())
+    {
+        ptr = ar.GetSharedObject<T>(index); // Already loaded
+    }
+    else if (index == ar.GetNumSharedObjects() + 1)
+    {
+        ptr = std::shared_ptr<T>(MakeNew<T>());
+        ar.AddSharedObject(ptr, GetTypeKey<T>());
+        Io(ar, *ptr);
+    }
+    else
+    {
+        ar.SetError();
+    }
+}
+
+template<class AR, typename T> void Io(AR& ar, std::map<std::string, T>& map)
+{
+    uint32_t count = static_cast<uint32_t>(map.size());
+    ar.Pod(count);
+    if (AR::IS_READING)
+    {
+        map.clear();
+        if (!ar.CheckCount(count))
+        {
+            return;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            std::string key;
+            Io(ar, key);
+            Io(ar, map[key]);
+        }
+    }
+    else
+    {
+        for (auto& pair: map)
+        {
+            std::string key = pair.first;
+            Io(ar, key);
+            Io(ar, pair.second);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------
+// Nodes
+
+template<class AR> void Io(AR& ar, Node::Id& id)
+{
+    uint8_t type = (id.IsTypeNumbered()) ? 1 : ((id.IsTypeNamed()) ? 2 : 0);
+    unsigned int num = id.Num();
+    std::string str = id.Str();
+    IoAll(ar, type, num, str);
+    if (AR::IS_READING)
+    {
+        if (type == 1)
+            id.SetNum(num);
+        else if (type == 2)
+            id.SetStr(str);
+        else
+            id.Invalidate();
+    }
+}
+
+template<class AR> void Io(AR& ar, Node::Ref& ref)
+{
+    std::string str = ref.Str();
+    unsigned int num = ref.Num();
+    unsigned int line = ref.GetLineNumber();
+    unsigned int flags = 0;
+    if (ref.GetImportState_IsValid())             { flags |= Node::Ref::IMPORT_STATE_IS_VALID; }
+    if (ref.GetImportState_MustCheckNamedFirst()) { flags |= Node::Ref::IMPORT_STATE_MUST_CHECK_NAMED_FIRST; }
+    if (ref.GetImportState_IsResolvedNamed())     { flags |= Node::Ref::IMPORT_STATE_IS_RESOLVED_NAMED; }
+    if (ref.GetImportState_IsResolvedNumbered())  { flags |= Node::Ref::IMPORT_STATE_IS_RESOLVED_NUMBERED; }
+    if (ref.GetRegularState_IsValid())            { flags |= Node::Ref::REGULAR_STATE_IS_VALID; }
+    if (ref.GetRegularState_IsNamed())            { flags |= Node::Ref::REGULAR_STATE_IS_NAMED; }
+    if (ref.GetRegularState_IsNumbered())         { flags |= Node::Ref::REGULAR_STATE_IS_NUMBERED; }
+    IoAll(ar, str, num, line, flags);
+    if (AR::IS_READING)
+    {
+        ref = Node::Ref(str, num, flags, line);
+    }
+}
+
+template<class AR> void Io(AR& ar, Node::Range& v)
+{
+    IoAll(ar, v.start, v.end);
+}
+
+template<class AR> void Io(AR& ar, Node& v)
+{
+    IoAll(ar, v.id, v.position, v.options, v.load_weight_override, v._has_load_weight_override,
+        v.node_defaults, v.node_minimass, v.beam_defaults, v.detacher_group);
+}
+
+// --------------------------------------------------------------------------------
+// Defaults/presets
+
+template<class AR> void Io(AR& ar, CameraSettings& v)
+{
+    IoAll(ar, v.mode, v.cinecam_index);
+}
+
+template<class AR> void Io(AR& ar, NodeDefaults& v)
+{
+    IoAll(ar, v.load_weight, v.friction, v.volume, v.surface, v.options);
+}
+
+template<class AR> void Io(AR& ar, BeamDefaultsScale& v)
+{
+    IoAll(ar, v.springiness, v.damping_constant, v.deformation_threshold_constant, v.breaking_threshold_constant);
+}
+
+template<class AR> void Io(AR& ar, BeamDefaults& v)
+{
+    IoAll(ar, v.springiness, v.damping_constant, v.deformation_threshold, v.breaking_threshold,
+        v.visual_beam_diameter, v.beam_material_name, v.plastic_deform_coef, v._enable_advanced_deformation,
+        v._is_plastic_deform_coef_user_defined, v._is_user_defined, v.scale);
+}
+
+template<class AR> void Io(AR& ar, MinimassPreset& v)
+{
+    IoAll(ar, v.min_mass);
+}
+
+template<class AR> void Io(AR& ar, Inertia& v)
+{
+    IoAll(ar, v.start_delay_factor, v.stop_delay_factor, v.start_function, v.stop_function);
+}
+
+template<class AR> void Io(AR& ar, ManagedMaterialsOptions& v)
+{
+    IoAll(ar, v.double_sided);
+}
+
+template<class AR> void Io(AR& ar, SkeletonSettings& v)
+{
+    IoAll(ar, v.visibility_range_meters, v.beam_thickness_meters);
+}
+
+// --------------------------------------------------------------------------------
+// Sections
+
+template<class AR> void Io(AR& ar, Globals& v)
+{
+    IoAll(ar, v.dry_mass, v.cargo_mass, v.material_name);
+}
+
+template<class AR> void Io(AR& ar, GuiSettings& v)
+{
+    IoAll(ar, v.tacho_material, v.speedo_material, v.speedo_highest_kph, v.use_max_rpm, v.help_material,
+        v.interactive_overview_map_mode, v.dashboard_layouts, v.rtt_dashboard_layouts);
+}
+
+template<class AR> void Io(AR& ar, Airbrake& v)
+{
+    IoAll(ar, v.reference_node, v.x_axis_node, v.y_axis_node, v.aditional_node, v.offset, v.width, v.height,
+        v.max_inclination_angle, v.texcoord_x1, v.texcoord_x2, v.texcoord_y1, v.texcoord_y2, v.lift_coefficient);
+}
+
+template<class AR> void Io(AR& ar, Animation::MotorSource& v)
+{
+    IoAll(ar, v.source, v.motor);
+}
+
+template<class AR> void Io(AR& ar, Animation& v)
+{
+    IoAll(ar, v.ratio, v.lower_limit, v.upper_limit, v.source, v.motor_sources, v.mode, v.event);
+}
+
+template<class AR> void Io(AR& ar, Axle& v)
+{
+    IoAll(ar, v.wheels, v.options);
+}
+
+template<class AR> void Io(AR& ar, InterAxle& v)
+{
+    IoAll(ar, v.a1, v.a2, v.options);
+}
+
+template<class AR> void Io(AR& ar, TransferCase& v)
+{
+    IoAll(ar, v.a1, v.a2, v.has_2wd, v.has_2wd_lo, v.gear_ratios);
+}
+
+template<class AR> void Io(AR& ar, Beam& v)
+{
+    IoAll(ar, v.nodes, v.options, v.extension_break_limit, v._has_extension_break_limit, v.detacher_group, v.defaults);
+}
+
+template<class AR> void Io(AR& ar, Camera& v)
+{
+    IoAll(ar, v.center_node, v.back_node, v.left_node);
+}
+
+template<class AR> void Io(AR& ar, CameraRail& v)
+{
+    IoAll(ar, v.nodes);
+}
+
+template<class AR> void Io(AR& ar, Cinecam& v)
+{
+    IoAll(ar, v.position, v.nodes, v.spring, v.damping, v.node_mass, v.beam_defaults, v.node_defaults);
+}
+
+template<class AR> void Io(AR& ar, CollisionBox& v)
+{
+    IoAll(ar, v.nodes);
+}
+
+template<class AR> void Io(AR& ar, CruiseControl& v)
+{
+    IoAll(ar, v.min_speed, v.autobrake);
+}
+
+template<class AR> void Io(AR& ar, Author& v)
+{
+    IoAll(ar, v.type, v.forum_account_id, v.name, v.email, v._has_forum_account);
+}
+
+template<class AR> void Io(AR& ar, Fileinfo& v)
+{
+    IoAll(ar, v.unique_id, v.category_id, v.file_version);
+}
+
+template<class AR> void Io(AR& ar, Engine& v)
+{
+    IoAll(ar, v.shift_down_rpm, v.shift_up_rpm, v.torque, v.global_gear_ratio, v.reverse_gear_ratio,
+        v.neutral_gear_ratio, v.gear_ratios);
+}
+
+template<class AR> void Io(AR& ar, Engoption& v)
+{
+    IoAll(ar, v.inertia, v.type, v.clutch_force, v.shift_time, v.clutch_time, v.post_shift_time, v.idle_rpm,
+        v.stall_rpm, v.max_idle_mixture, v.min_idle_mixture, v.braking_torque);
+}
+
+template<class AR> void Io(AR& ar, Engturbo& v)
+{
+    IoAll(ar, v.version, v.tinertiaFactor, v.nturbos, v.param1, v.param2, v.param3, v.param4, v.param5,
+        v.param6, v.param7, v.param8, v.param9, v.param10, v.param11);
+}
+
+template<class AR> void Io(AR& ar, Exhaust& v)
+{
+    IoAll(ar, v.reference_node, v.direction_node, v.particle_name);
+}
+
+template<class AR> void Io(AR& ar, ExtCamera& v)
+{
+    IoAll(ar, v.mode, v.node);
+}
+
+template<class AR> void Io(AR& ar, Brakes& v)
+{
+    IoAll(ar, v.default_braking_force, v.parking_brake_force);
+}
+
+template<class AR> void Io(AR& ar, AntiLockBrakes& v)
+{
+    IoAll(ar, v.regulation_force, v.min_speed, v.pulse_per_sec, v.attr_is_on, v.attr_no_dashboard, v.attr_no_toggle);
+}
+
+template<class AR> void Io(AR& ar, TractionControl& v)
+{
+    IoAll(ar, v.regulation_force, v.wheel_slip, v.fade_speed, v.pulse_per_sec, v.attr_is_on,
+        v.attr_no_dashboard, v.attr_no_toggle);
+}
+
+template<class AR> void Io(AR& ar, SlopeBrake& v)
+{
+    IoAll(ar, v.regulating_force, v.attach_angle, v.release_angle);
+}
+
+template<class AR> void Io(AR& ar, WheelDetacher& v)
+{
+    IoAll(ar, v.wheel_id, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, BaseWheel& v)
+{
+    IoAll(ar, v.width, v.num_rays, v.nodes, v.rigidity_node, v.braking, v.propulsion, v.reference_arm_node,
+        v.mass, v.node_defaults, v.beam_defaults);
+}
+
+template<class AR> void Io(AR& ar, Wheel& v)
+{
+    Io(ar, static_cast<BaseWheel&>(v));
+    IoAll(ar, v.radius, v.springiness, v.damping, v.face_material_name, v.band_material_name);
+}
+
+template<class AR> void Io(AR& ar, BaseWheel2& v)
+{
+    Io(ar, static_cast<BaseWheel&>(v));
+    IoAll(ar, v.rim_radius, v.tyre_radius, v.tyre_springiness, v.tyre_damping);
+}
+
+template<class AR> void Io(AR& ar, Wheel2& v)
+{
+    Io(ar, static_cast<BaseWheel2&>(v));
+    IoAll(ar, v.face_material_name, v.band_material_name, v.rim_springiness, v.rim_damping);
+}
+
+template<class AR> void Io(AR& ar, MeshWheel& v)
+{
+    Io(ar, static_cast<BaseWheel&>(v));
+    IoAll(ar, v.side, v.mesh_name, v.material_name, v.rim_radius, v.tyre_radius, v.spring, v.damping, v._is_meshwheel2);
+}
+
+template<class AR> void Io(AR& ar, Flare2& v)
+{
+    IoAll(ar, v.reference_node, v.node_axis_x, v.node_axis_y, v.offset, v.type, v.control_number,
+        v.blink_delay_milis, v.size, v.material_name);
+}
+
+template<class AR> void Io(AR& ar, Flexbody& v)
+{
+    IoAll(ar, v.reference_node, v.x_axis_node, v.y_axis_node, v.offset, v.rotation, v.mesh_name, v.animations,
+        v.node_list_to_import, v.node_list, v.camera_settings);
+}
+
+template<class AR> void Io(AR& ar, FlexBodyWheel& v)
+{
+    Io(ar, static_cast<BaseWheel2&>(v));
+    IoAll(ar, v.side, v.rim_springiness, v.rim_damping, v.rim_mesh_name, v.tyre_mesh_name);
+}
+
+template<class AR> void Io(AR& ar, Fusedrag& v)
+{
+    IoAll(ar, v.autocalc, v.front_node, v.rear_node, v.approximate_width, v.airfoil_name, v.area_coefficient);
+}
+
+template<class AR> void Io(AR& ar, Hook& v)
+{
+    IoAll(ar, v.node, v.option_hook_range, v.option_speed_coef, v.option_max_force, v.option_hookgroup,
+        v.option_lockgroup, v.option_timer, v.option_min_range_meters);
+
+    // Bit fields cannot be bound to references
+    bool self_lock  = v.flag_self_lock;
+    bool auto_lock  = v.flag_auto_lock;
+    bool no_disable = v.flag_no_disable;
+    bool no_rope    = v.flag_no_rope;
+    bool visible    = v.flag_visible;
+    IoAll(ar, self_lock, auto_lock, no_disable, no_rope, visible);
+    v.flag_self_lock  = self_lock;
+    v.flag_auto_lock  = auto_lock;
+    v.flag_no_disable = no_disable;
+    v.flag_no_rope    = no_rope;
+    v.flag_visible    = visible;
+}
+
+template<class AR> void Io(AR& ar, Shock& v)
+{
+    IoAll(ar, v.nodes, v.spring_rate, v.damping, v.short_bound, v.long_bound, v.precompression, v.options,
+        v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, Shock2& v)
+{
+    IoAll(ar, v.nodes, v.spring_in, v.damp_in, v.progress_factor_spring_in, v.progress_factor_damp_in,
+        v.spring_out, v.damp_out, v.progress_factor_spring_out, v.progress_factor_damp_out, v.short_bound,
+        v.long_bound, v.precompression, v.options, v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, Shock3& v)
+{
+    IoAll(ar, v.nodes, v.spring_in, v.damp_in, v.spring_out, v.damp_out, v.damp_in_slow, v.split_vel_in,
+        v.damp_in_fast, v.damp_out_slow, v.split_vel_out, v.damp_out_fast, v.short_bound, v.long_bound,
+        v.precompression, v.options, v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, Hydro& v)
+{
+    IoAll(ar, v.nodes, v.lenghtening_factor, v.options, v.inertia, v.inertia_defaults, v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, AeroAnimator& v)
+{
+    IoAll(ar, v.flags, v.motor);
+}
+
+template<class AR> void Io(AR& ar, Animator& v)
+{
+    IoAll(ar, v.nodes, v.lenghtening_factor, v.flags, v.short_limit, v.long_limit, v.aero_animator,
+        v.inertia_defaults, v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, Command2& v)
+{
+    IoAll(ar, v._format_version, v.nodes, v.shorten_rate, v.lengthen_rate, v.max_contraction, v.max_extension,
+        v.contract_key, v.extend_key, v.description, v.inertia, v.affect_engine, v.needs_engine, v.plays_sound,
+        v.beam_defaults, v.inertia_defaults, v.detacher_group);
+    IoAll(ar, v.option_i_invisible, v.option_r_rope, v.option_c_auto_center, v.option_f_not_faster,
+        v.option_p_1press, v.option_o_1press_center);
+}
+
+template<class AR> void Io(AR& ar, Rotator& v)
+{
+    IoAll(ar, v.axis_nodes, v.base_plate_nodes, v.rotating_plate_nodes, v.rate, v.spin_left_key,
+        v.spin_right_key, v.inertia, v.inertia_defaults, v.engine_coupling, v.needs_engine);
+}
+
+template<class AR> void Io(AR& ar, Rotator2& v)
+{
+    Io(ar, static_cast<Rotator&>(v));
+    IoAll(ar, v.rotating_force, v.tolerance, v.description);
+}
+
+template<class AR> void Io(AR& ar, Trigger& v)
+{
+    IoAll(ar, v.nodes, v.contraction_trigger_limit, v.expansion_trigger_limit, v.options, v.boundary_timer,
+        v.beam_defaults, v.detacher_group, v.shortbound_trigger_action, v.longbound_trigger_action);
+}
+
+template<class AR> void Io(AR& ar, Lockgroup& v)
+{
+    IoAll(ar, v.number, v.nodes);
+}
+
+template<class AR> void Io(AR& ar, ManagedMaterial& v)
+{
+    IoAll(ar, v.name, v.type, v.options, v.diffuse_map, v.damaged_diffuse_map, v.specular_map);
+}
+
+template<class AR> void Io(AR& ar, MaterialFlareBinding& v)
+{
+    IoAll(ar, v.flare_number, v.material_name);
+}
+
+template<class AR> void Io(AR& ar, NodeCollision& v)
+{
+    IoAll(ar, v.node, v.radius);
+}
+
+template<class AR> void Io(AR& ar, Particle& v)
+{
+    IoAll(ar, v.emitter_node, v.reference_node, v.particle_system_name);
+}
+
+template<class AR> void Io(AR& ar, Pistonprop& v)
+{
+    IoAll(ar, v.reference_node, v.axis_node, v.blade_tip_nodes, v.couple_node, v.turbine_power_kW, v.pitch, v.airfoil);
+}
+
+template<class AR> void Io(AR& ar, Prop::DashboardSpecial& v)
+{
+    IoAll(ar, v.offset, v._offset_is_set, v.rotation_angle, v.mesh_name);
+}
+
+template<class AR> void Io(AR& ar, Prop::BeaconSpecial& v)
+{
+    IoAll(ar, v.flare_material_name, v.color);
+}
+
+template<class AR> void Io(AR& ar, Prop& v)
+{
+    IoAll(ar, v.reference_node, v.x_axis_node, v.y_axis_node, v.offset, v.rotation, v.mesh_name, v.animations,
+        v.camera_settings, v.special, v.special_prop_beacon, v.special_prop_dashboard);
+}
+
+template<class AR> void Io(AR& ar, RailGroup& v)
+{
+    IoAll(ar, v.id, v.node_list);
+}
+
+template<class AR> void Io(AR& ar, Ropable& v)
+{
+    IoAll(ar, v.node, v.group, v.has_multilock);
+}
+
+template<class AR> void Io(AR& ar, Rope& v)
+{
+    IoAll(ar, v.root_node, v.end_node, v.invisible, v.beam_defaults, v.detacher_group);
+}
+
+template<class AR> void Io(AR& ar, Screwprop& v)
+{
+    IoAll(ar, v.prop_node, v.back_node, v.top_node, v.power);
+}
+
+template<class AR> void Io(AR& ar, SlideNode& v)
+{
+    IoAll(ar, v.slide_node, v.rail_node_ranges, v.spring_rate, v.break_force, v.tolerance, v.railgroup_id,
+        v._railgroup_id_set, v.attachment_rate, v.max_attachment_distance, v._break_force_set, v.constraint_flags);
+}
+
+template<class AR> void Io(AR& ar, SoundSource& v)
+{
+    IoAll(ar, v.node, v.sound_script_name);
+}
+
+template<class AR> void Io(AR& ar, SoundSource2& v)
+{
+    Io(ar, static_cast<SoundSource&>(v));
+    IoAll(ar, v.mode, v.cinecam_index);
+}
+
+template<class AR> void Io(AR& ar, SpeedLimiter& v)
+{
+    IoAll(ar, v.max_speed, v.is_enabled);
+}
+
+template<class AR> void Io(AR& ar, Cab& v)
+{
+    IoAll(ar, v.nodes, v.options);
+}
+
+template<class AR> void Io(AR& ar, Texcoord& v)
+{
+    IoAll(ar, v.node, v.u, v.v);
+}
+
+template<class AR> void Io(AR& ar, Submesh& v)
+{
+    IoAll(ar, v.backmesh, v.texcoords, v.cab_triangles);
+}
+
+template<class AR> void Io(AR& ar, Tie& v)
+{
+    IoAll(ar, v.root_node, v.max_reach_length, v.auto_shorten_rate, v.min_length, v.max_length, v.is_invisible,
+        v.disable_self_lock, v.max_stress, v.beam_defaults, v.detacher_group, v.group);
+}
+
+template<class AR> void Io(AR& ar, TorqueCurve::Sample& v)
+{
+    IoAll(ar, v.power, v.torque_percent);
+}
+
+template<class AR> void Io(AR& ar, TorqueCurve& v)
+{
+    IoAll(ar, v.samples, v.predefined_func_name);
+}
+
+template<class AR> void Io(AR& ar, Turbojet& v)
+{
+    IoAll(ar, v.front_node, v.back_node, v.side_node, v.is_reversable, v.dry_thrust, v.wet_thrust,
+        v.front_diameter, v.back_diameter, v.nozzle_length);
+}
+
+template<class AR> void Io(AR& ar, Turboprop2& v)
+{
+    IoAll(ar, v.reference_node, v.axis_node, v.blade_tip_nodes, v.turbine_power_kW, v.airfoil, v.couple_node, v._format_version);
+}
+
+template<class AR> void Io(AR& ar, VideoCamera& v)
+{
+    IoAll(ar, v.reference_node, v.left_node, v.bottom_node, v.alt_reference_node, v.alt_orientation_node,
+        v.offset, v.rotation, v.field_of_view, v.texture_width, v.texture_height, v.min_clip_distance,
+        v.max_clip_distance, v.camera_role, v.camera_mode, v.material_name, v.camera_name);
+}
+
+template<class AR> void Io(AR& ar, Wing& v)
+{
+    IoAll(ar, v.nodes, v.tex_coords, v.control_surface, v.chord_point, v.min_deflection, v.max_deflection,
+        v.airfoil, v.efficacy_coef);
+}
+
+// --------------------------------------------------------------------------------
+// Root document
+
+template<class AR> void Io(AR& ar, File::Module& m)
+{
+    IoAll(ar, m.name, m.help_panel_material_name, m.contacter_nodes);
+    IoAll(ar, m.airbrakes, m.animators, m.anti_lock_brakes, m.axles, m.beams, m.brakes, m.cameras,
+        m.camera_rails, m.collision_boxes, m.cinecam, m.commands_2, m.cruise_control, m.contacters);
+    IoAll(ar, m.engine, m.engoption, m.engturbo, m.exhausts, m.ext_camera, m.fixes, m.flares_2, m.flexbodies,
+        m.flex_body_wheels, m.fusedrag, m.globals, m.gui_settings, m.hooks, m.hydros, m.interaxles);
+    IoAll(ar, m.lockgroups, m.managed_materials, m.material_flare_bindings, m.mesh_wheels, m.nodes,
+        m.node_collisions, m.particles, m.pistonprops, m.props, m.railgroups, m.ropables, m.ropes);
+    IoAll(ar, m.rotators, m.rotators_2, m.screwprops, m.shocks, m.shocks_2, m.shocks_3, m.skeleton_settings,
+        m.slidenodes, m.slope_brake, m.soundsources, m.soundsources2, m.speed_limiter,
+        m.submeshes_ground_model_name, m.submeshes);
+    IoAll(ar, m.ties, m.torque_curve, m.traction_control, m.transfer_case, m.triggers, m.turbojets,
+        m.turboprops_2, m.videocameras, m.wheeldetachers, m.wheels, m.wheels_2, m.wings);
+}
+
+template<class AR> void Io(AR& ar, File& f)
+{
+    IoAll(ar, f.file_format_version, f.guid, f.description, f.hide_in_chooser, f.enable_advanced_deformation,
+        f.slide_nodes_connect_instantly, f.rollon, f.forward_commands, f.import_commands,
+        f.lockgroup_default_nolock, f.rescuer, f.disable_default_sounds, f.name, f.collision_range, f.hash);
+    IoAll(ar, f.root_module, f.user_modules, f.authors, f.file_info, f.global_minimass, f.minimass_skip_loaded_nodes);
+}
+
+/// Changes whenever the layout of the serialized structs changes (in most cases, at least).
+uint32_t GetLayoutCheck()
+{
+    const size_t sizes[] =
+    {
+        sizeof(Node), sizeof(Node::Ref), sizeof(Beam), sizeof(BeamDefaults), sizeof(NodeDefaults), sizeof(Inertia),
+        sizeof(Globals), sizeof(GuiSettings), sizeof(Airbrake), sizeof(Animation), sizeof(Axle), sizeof(InterAxle),
+        sizeof(TransferCase), sizeof(Cinecam), sizeof(Author), sizeof(Fileinfo), sizeof(Engine), sizeof(Engoption),
+        sizeof(Engturbo), sizeof(Exhaust), sizeof(ExtCamera), sizeof(AntiLockBrakes), sizeof(TractionControl),
+        sizeof(Wheel), sizeof(Wheel2), sizeof(MeshWheel), sizeof(Flare2), sizeof(Flexbody), sizeof(FlexBodyWheel),
+        sizeof(Fusedrag), sizeof(Hook), sizeof(Shock), sizeof(Shock2), sizeof(Shock3), sizeof(Hydro),
+        sizeof(Animator), sizeof(Command2), sizeof(Rotator2), sizeof(Trigger), sizeof(ManagedMaterial),
+        sizeof(Pistonprop), sizeof(Prop), sizeof(SlideNode), sizeof(SoundSource2), sizeof(Cab), sizeof(Texcoord),
+        sizeof(Tie), sizeof(Turbojet), sizeof(Turboprop2), sizeof(VideoCamera), sizeof(Wing),
+        sizeof(File::Module), sizeof(File)
+    };
+    uint32_t check = 2166136261u; // FNV-1a
+    for (size_t size: sizes)
+    {
+        check = (check ^ static_cast<uint32_t>(size)) * 16777619u;
+    }
+    return check;
+}
+
+} // namespace BinaryIO
+} // namespace RigDef
+
+using namespace RigDef::BinaryIO;
+
+void BinarySerializer::Serialize(File& def, Fingerprint const& source, std::vector<char>& out_data)
+{
+    out_data.clear();
+    out_data.resize(sizeof(FileHeader)); // Filled in below
+
+    Writer writer(out_data);
+    Io(writer, def);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::strncpy(header.signature, SIGNATURE, sizeof(header.signature));
+    header.file_format_version = FILE_FORMAT_VERSION;
+    header.layout_check        = GetLayoutCheck();
+    header.source_size         = source.size;
+    header.source_time         = source.time;
+    header.payload_size        = out_data.size() - sizeof(FileHeader);
+    std::memcpy(out_data.data(), &header, sizeof(FileHeader));
+}
+
+std::shared_ptr<File> BinarySerializer::Deserialize(const char* data, size_t length, Fingerprint const& source)
+{
+    if (length < sizeof(FileHeader))
+    {
+        return nullptr;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(FileHeader));
+    if (std::strncmp(header.signature, SIGNATURE, sizeof(header.signature)) != 0 ||
+        header.file_format_version != FILE_FORMAT_VERSION ||
+        header.layout_check != GetLayoutCheck() ||
+        header.source_size != source.size ||
+        header.source_time != source.time ||
+        header.payload_size != length - sizeof(FileHeader))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<File> def = std::make_shared<File>();
+    Reader reader(data + sizeof(FileHeader), length - sizeof(FileHeader));
+    Io(reader, *def);
+    if (reader.HasError() || !reader.IsAtEnd() || def->root_module == nullptr)
+    {
+        return nullptr;
+    }
+    return def;
+}
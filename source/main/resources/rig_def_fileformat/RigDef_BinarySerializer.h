@@ -0,0 +1,60 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Compiled (binary) form of RigDef::File, used to skip parsing on spawn.
+
+#pragma once
+
+#include "RigDef_File.h"
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace RigDef
+{
+
+/// Writes/reads the complete RigDef::File data structure (all modules and sections) in a compact binary form.
+/// The output is only valid for the source file it was compiled from (see `Fingerprint`) and for the
+/// build which wrote it (see `FILE_FORMAT_VERSION`) - it's a cache, not an interchange format.
+class BinarySerializer
+{
+public:
+    static const char*        SIGNATURE;
+    static const unsigned int FILE_FORMAT_VERSION = 2; //!< Bump whenever a struct in RigDef_File.h or RigDef_Node.h, or what the parser produces, changes!
+
+    /// Identifies the version of the source truckfile.
+    struct Fingerprint
+    {
+        Fingerprint(): size(0), time(0) {}
+        Fingerprint(uint64_t s, std::time_t t): size(s), time(static_cast<int64_t>(t)) {}
+
+        uint64_t size;
+        int64_t  time;
+    };
+
+    static void                  Serialize(File& def, Fingerprint const& source, std::vector<char>& out_data);
+    static std::shared_ptr<File> Deserialize(const char* data, size_t length, Fingerprint const& source); //!< Returns nullptr if outdated or damaged.
+};
+
+} // namespace RigDef
@@ -36,6 +36,8 @@
     NOTES: 
     * Since these are open structs, the m_ prefix for member variables is not used.
     * Members prefixed by _ are helper flags which mark special values or missing values.
+    * All structs are also written to binary cache by RigDef_BinarySerializer.cpp;
+      when adding/changing a member, update it there and bump its FILE_FORMAT_VERSION.
 */
 
 #pragma once
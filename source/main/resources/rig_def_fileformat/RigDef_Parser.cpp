@@ -38,6 +38,9 @@
 #include <OgreStringVector.h>
 #include <OgreStringConverter.h>
 
+#include <cstring>
+#include <iterator>
+
 using namespace RoR;
 
 namespace RigDef
@@ -63,6 +66,94 @@ inline bool StrEqualsNocase(std::string const & s1, std::string const & s2)
     return true;
 }
 
+/// Like `str + count`, but never past the terminating NUL (lines are parsed in place, the next line follows).
+inline const char* SkipChars(const char* str, size_t count)
+{
+    return str + strnlen(str, count);
+}
+
+/// Fast path for plain decimal numbers (by far the most common truckfile argument).
+/// Mantissa and power of 10 are both exact in `double`, so the division is correctly
+/// rounded and the result is identical to `strtod()`. Returns false for anything else
+/// (exponents, too many digits, trailing characters...) so callers can fall back.
+inline bool TryParseDecimal(const char* start, const char* end, double& out_value)
+{
+    static const double POW10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    const char* pos = start;
+    const bool negative = (pos != end && *pos == '-');
+    if (pos != end && (*pos == '-' || *pos == '+'))
+    {
+        ++pos;
+    }
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int num_decimals = 0;
+    bool in_decimals = false;
+    for (; pos != end; ++pos)
+    {
+        if (*pos >= '0' && *pos <= '9')
+        {
+            if (++num_digits > 15)
+            {
+                return false;
+            }
+            mantissa = (mantissa * 10) + (*pos - '0');
+            if (in_decimals)
+            {
+                ++num_decimals;
+            }
+        }
+        else if (*pos == '.' && !in_decimals)
+        {
+            in_decimals = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (num_digits == 0 || num_decimals > 22)
+    {
+        return false;
+    }
+
+    const double value = static_cast<double>(mantissa) / POW10[num_decimals];
+    out_value = (negative) ? -value : value;
+    return true;
+}
+
+/// Integer counterpart of `TryParseDecimal()`; 9 digits always fit in `long`.
+inline bool TryParseInteger(const char* start, const char* end, long& out_value)
+{
+    const char* pos = start;
+    const bool negative = (pos != end && *pos == '-');
+    if (pos != end && (*pos == '-' || *pos == '+'))
+    {
+        ++pos;
+    }
+
+    if (pos == end || (end - pos) > 9)
+    {
+        return false;
+    }
+
+    long value = 0;
+    for (; pos != end; ++pos)
+    {
+        if (*pos < '0' || *pos > '9')
+        {
+            return false;
+        }
+        value = (value * 10) + (*pos - '0');
+    }
+
+    out_value = (negative) ? -value : value;
+    return true;
+}
+
 #define STR_PARSE_INT(_STR_)  Ogre::StringConverter::parseInt(_STR_)
 
 #define STR_PARSE_REAL(_STR_) Ogre::StringConverter::parseReal(_STR_)
@@ -431,7 +522,7 @@ void Parser::ParseWheelDetachers()
 
 void Parser::ParseTractionControl()
 {
-    Ogre::StringVector tokens = Ogre::StringUtil::split(m_current_line + 15, ","); // "TractionControl" = 15 characters
+    Ogre::StringVector tokens = Ogre::StringUtil::split(SkipChars(m_current_line, 15), ","); // "TractionControl" = 15 characters
     if (tokens.size() < 2)
     {
         this->AddMessage(Message::TYPE_ERROR, "Too few arguments");
@@ -1102,7 +1193,7 @@ void Parser::ParseFlexbody()
         // * Pair of node numbers:" 123 - 456 ". Whitespace is optional.
 
         char setdef[LINE_BUFFER_LENGTH] = ""; // strtok() is destructive, we need own buffer.
-        strncpy(setdef, m_current_line + 6, LINE_BUFFER_LENGTH - 6); // Cut away "forset"
+        strncpy(setdef, SkipChars(m_current_line, 6), LINE_BUFFER_LENGTH - 6); // Cut away "forset"
         const char* item = std::strtok(setdef, ",");
 
         // TODO: Add error reporting
@@ -1285,7 +1376,7 @@ void Parser::ParseDirectiveAddAnimation()
         return;
     }
 
-    Ogre::StringVector tokens = Ogre::StringUtil::split(m_current_line + 14, ","); // "add_animation " = 14 characters
+    Ogre::StringVector tokens = Ogre::StringUtil::split(SkipChars(m_current_line, 14), ","); // "add_animation " = 14 characters
 
     if (tokens.size() < 4)
     {
@@ -1443,7 +1534,7 @@ void Parser::ParseDirectiveAddAnimation()
 void Parser::ParseAntiLockBrakes()
 {
     AntiLockBrakes alb;
-    Ogre::StringVector tokens = Ogre::StringUtil::split(m_current_line + 15, ","); // "AntiLockBrakes " = 15 characters
+    Ogre::StringVector tokens = Ogre::StringUtil::split(SkipChars(m_current_line, 15), ","); // "AntiLockBrakes " = 15 characters
     if (tokens.size() < 2)
     {
         this->AddMessage(Message::TYPE_ERROR, "Too few arguments for `AntiLockBrakes`");
@@ -2940,22 +3031,25 @@ void Parser::ParseManagedMaterials()
         return;
     }
 
-    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
-
-    if (!rgm.resourceExists(m_resource_group, managed_mat.diffuse_map))
-    {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.diffuse_map);
-        return;
-    }
-    if (managed_mat.HasDamagedDiffuseMap() && !rgm.resourceExists(m_resource_group, managed_mat.damaged_diffuse_map))
+    if (m_check_resources) // Otherwise the caller checks on main thread, see `SetCheckResources()`
     {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.damaged_diffuse_map);
-        managed_mat.damaged_diffuse_map = "-";
-    }
-    if (managed_mat.HasSpecularMap() && !rgm.resourceExists(m_resource_group, managed_mat.specular_map))
-    {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.specular_map);
-        managed_mat.specular_map = "-";
+        Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+
+        if (!rgm.resourceExists(m_resource_group, managed_mat.diffuse_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.diffuse_map);
+            return;
+        }
+        if (managed_mat.HasDamagedDiffuseMap() && !rgm.resourceExists(m_resource_group, managed_mat.damaged_diffuse_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.damaged_diffuse_map);
+            managed_mat.damaged_diffuse_map = "-";
+        }
+        if (managed_mat.HasSpecularMap() && !rgm.resourceExists(m_resource_group, managed_mat.specular_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.specular_map);
+            managed_mat.specular_map = "-";
+        }
     }
 
     m_current_module->managed_materials.push_back(managed_mat);
@@ -3265,6 +3359,8 @@ void Parser::Prepare()
     m_current_section = File::SECTION_TRUCK_NAME;
     m_current_subsection = File::SUBSECTION_NONE;
     m_current_line_number = 1;
+    m_line_buffer[0] = '\0';
+    m_current_line = m_line_buffer;
     m_definition = std::shared_ptr<File>(new File());
     m_in_block_comment = false;
     m_in_description_section = false;
@@ -3431,6 +3527,12 @@ MeshWheel::Side Parser::GetArgWheelSide(int index)
 
 long Parser::GetArgLong(int index)
 {
+    long fast_res = 0;
+    if (TryParseInteger(m_args[index].start, m_args[index].start + m_args[index].length, fast_res))
+    {
+        return fast_res;
+    }
+
     errno = 0;
     char* out_end = nullptr;
     const int MSG_LEN = 200;
@@ -3531,6 +3633,12 @@ Flare2::Type Parser::GetArgFlareType(int index)
 
 float Parser::GetArgFloat(int index)
 {
+    double fast_res = 0.0;
+    if (TryParseDecimal(m_args[index].start, m_args[index].start + m_args[index].length, fast_res))
+    {
+        return static_cast<float>(fast_res);
+    }
+
     errno = 0;
     char* out_end = nullptr;
     float res = std::strtod(m_args[index].start, &out_end);
@@ -3676,49 +3784,93 @@ void Parser::ProcessOgreStream(Ogre::DataStream* stream, Ogre::String resource_g
     m_resource_group = resource_group;
     m_filename = stream->getName();
 
-    char raw_line_buf[LINE_BUFFER_LENGTH];
-    while (!stream->eof())
+    std::string contents;
+    try
+    {
+        contents = stream->getAsString();
+    }
+    catch (Ogre::Exception &ex)
     {
-        try
+        std::string msg = "Error reading truckfile! Message:\n";
+        msg += ex.getFullDescription();
+        this->AddMessage(Message::TYPE_FATAL_ERROR, msg.c_str());
+        return;
+    }
+
+    // Validate UTF-8 once for the whole file; only sanitize (copy) if needed.
+    if (utf8::find_invalid(contents.begin(), contents.end()) != contents.end())
+    {
+        std::string sanitized;
+        sanitized.reserve(contents.size());
+        utf8::replace_invalid(contents.begin(), contents.end(), std::back_inserter(sanitized), '?');
+        contents.swap(sanitized);
+    }
+
+    const size_t len = contents.size();
+    contents.push_back('\0'); // `ProcessBuffer()` terminates the last line at `buf[len]`
+    this->ProcessBuffer(&contents[0], len);
+}
+
+void Parser::ProcessBuffer(char* buf, size_t len)
+{
+    char* buf_end = buf + len;
+    char* line_start = buf;
+    while (line_start < buf_end)
+    {
+        char* line_end = static_cast<char*>(memchr(line_start, '\n', buf_end - line_start));
+        if (line_end == nullptr)
         {
-            stream->readLine(raw_line_buf, LINE_BUFFER_LENGTH);
+            line_end = buf_end;
         }
-        catch (Ogre::Exception &ex)
+        char* next_line = (line_end == buf_end) ? buf_end : (line_end + 1);
+
+        // Mimic `Ogre::DataStream::readLine()` which we used before: strip CR, limit length.
+        if ((line_end != line_start) && (*(line_end - 1) == '\r'))
         {
-            std::string msg = "Error reading truckfile! Message:\n";
-            msg += ex.getFullDescription();
-            this->AddMessage(Message::TYPE_FATAL_ERROR, msg.c_str());
-            break;
+            --line_end;
+        }
+        if (line_end - line_start > LINE_BUFFER_LENGTH - 1)
+        {
+            // Like `readLine()`, process the first `LINE_BUFFER_LENGTH - 1` chars and carry the rest over to the next line.
+            // Rare, so just go through the copying path - it stops at that length.
+            this->ProcessRawLine(line_start);
+            line_start += LINE_BUFFER_LENGTH - 1;
+            continue;
         }
 
-        this->ProcessRawLine(raw_line_buf);
+        *line_end = '\0'; // Terminate in place, no copy.
+        this->ProcessLine(line_start);
+        line_start = next_line;
     }
 }
 
 void Parser::ProcessRawLine(const char* raw_line_buf)
 {
-    const char* raw_start = raw_line_buf;
-    const char* raw_end = raw_line_buf + strnlen(raw_line_buf, LINE_BUFFER_LENGTH);
+    // Sanitize UTF-8 into own buffer; the replacement char is never longer than the invalid sequence.
+    const char* raw_end = raw_line_buf + strnlen(raw_line_buf, LINE_BUFFER_LENGTH - 1);
+    char* out_end = utf8::replace_invalid(raw_line_buf, raw_end, m_line_buffer, '?');
+    *out_end = '\0';
+
+    this->ProcessLine(m_line_buffer);
+}
 
+void Parser::ProcessLine(const char* line)
+{
     // Trim leading whitespace
-    while (IsWhitespace(*raw_start) && (raw_start != raw_end))
+    while (IsWhitespace(*line))
     {
-        ++raw_start;
+        ++line;
     }
 
     // Skip empty/comment lines
-    if ((raw_start == raw_end) || (*raw_start == ';') || (*raw_start == '/'))
+    if ((*line == '\0') || (*line == ';') || (*line == '/'))
     {
         ++m_current_line_number;
         return;
     }
 
-    // Sanitize UTF-8
-    memset(m_current_line, 0, LINE_BUFFER_LENGTH);
-    char* out_start = m_current_line;
-    utf8::replace_invalid(raw_start, raw_end, out_start, '?');
-
     // Process
+    m_current_line = line;
     this->ProcessCurrentLine();
     ++m_current_line_number;
 }
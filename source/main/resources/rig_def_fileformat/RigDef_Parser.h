@@ -81,8 +81,8 @@ public:
 
     void Prepare();
     void Finalize();
-    void ProcessOgreStream(Ogre::DataStream* stream, Ogre::String resource_group);
-    void ProcessRawLine(const char* line);
+    void ProcessOgreStream(Ogre::DataStream* stream, Ogre::String resource_group); //!< Reads the whole file at once and parses it in place.
+    void ProcessRawLine(const char* line); //!< Copies and sanitizes the line; prefer `ProcessOgreStream()` for whole files.
 
     std::shared_ptr<RigDef::File> GetFile()
     {
@@ -91,6 +91,10 @@ public:
 
     SequentialImporter* GetSequentialImporter() { return &m_sequential_importer; }
 
+    /// Managedmaterial texture files are checked against the resource group (OGRE resource system isn't thread-safe).
+    /// Turn off to parse on a worker thread; the caller must then run `ActorManager::CheckManagedMaterialTextures()` on main thread.
+    void SetCheckResources(bool check) { m_check_resources = check; }
+
 private:
 
 // --------------------------------------------------------------------------
@@ -195,6 +199,8 @@ private:
 //  Utilities
 // --------------------------------------------------------------------------
 
+    void             ProcessBuffer(char* buf, size_t len); //!< Splits lines in place; `buf[len]` must be writable.
+    void             ProcessLine(const char* line); //!< Line must be NUL-terminated, valid UTF-8.
     void             ProcessCurrentLine();
     int              TokenizeCurrentLine();
     bool             CheckNumArguments(int num_required_args);
@@ -280,7 +286,8 @@ private:
     std::shared_ptr<File::Module>        m_current_module;
 
     unsigned int                         m_current_line_number;
-    char                                 m_current_line[LINE_BUFFER_LENGTH];
+    const char*                          m_current_line;           //!< Left-trimmed, NUL-terminated; points to file buffer or `m_line_buffer`.
+    char                                 m_line_buffer[LINE_BUFFER_LENGTH]; //!< Used by `ProcessRawLine()`
     Token                                m_args[LINE_MAX_ARGS];    //!< Tokens of current line.
     int                                  m_num_args;               //!< Number of tokens on current line.
     File::Section                        m_current_section;        //!< Parser state.
@@ -296,6 +303,7 @@ private:
 
     Ogre::String                         m_filename; // Logging
     Ogre::String                         m_resource_group;
+    bool                                 m_check_resources = true; //!< See `SetCheckResources()`
 
     std::shared_ptr<RigDef::File>        m_definition;
 };
@@ -39,6 +39,8 @@ void Console::CVarSetupBuiltins()
     App::app_extra_mod_path      = this->CVarCreate("app_extra_mod_path",      "Extra mod path",             CVAR_ARCHIVE);
     App::app_force_cache_purge   = this->CVarCreate("app_force_cache_purge",   "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_force_cache_update  = this->CVarCreate("app_force_cache_update",  "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::app_export_cache_json   = this->CVarCreate("app_export_cache_json",   "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::app_cache_content_hash  = this->CVarCreate("app_cache_content_hash",  "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_disable_online_api  = this->CVarCreate("app_disable_online_api",  "Disable Online API",         CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_config_long_names   = this->CVarCreate("app_config_long_names",   "Config uses long names",     CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
 
@@ -174,6 +176,11 @@ void Console::CVarSetupBuiltins()
     App::gfx_reduce_shadows      = this->CVarCreate("gfx_reduce_shadows",      "Shadow optimizations",       CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::gfx_enable_rtshaders    = this->CVarCreate("gfx_enable_rtshaders",    "Use RTShader System",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_classic_shaders     = this->CVarCreate("gfx_classic_shaders",     "Classic material shaders",   CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_flexbody_culling    = this->CVarCreate("gfx_flexbody_culling",    "Flexbody culling",           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::gfx_flexbody_lod_range  = this->CVarCreate("gfx_flexbody_lod_range",  "Flexbody LOD range",         CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "150");
+    App::gfx_flexbody_lod_interval = this->CVarCreate("gfx_flexbody_lod_interval", "Flexbody LOD interval",  CVAR_ARCHIVE | CVAR_TYPE_INT,     "4");
+    App::gfx_flexbody_rigid_range = this->CVarCreate("gfx_flexbody_rigid_range", "Flexbody rigid range",     CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "400");
+    App::gfx_flares_max_lights   = this->CVarCreate("gfx_flares_max_lights",   "Max. flare light sources",   CVAR_ARCHIVE | CVAR_TYPE_INT,     "16");
 
 
 }
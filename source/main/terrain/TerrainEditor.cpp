@@ -155,6 +155,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
     if (m_object_index != -1 && App::GetInputEngine()->getEventBoolValueBounce(EV_COMMON_RESET_TRUCK))
     {
         SceneNode* sn = object_list[m_object_index].node;
+        App::GetSimTerrain()->getObjectManager()->UnbatchObjectVisuals(sn);
 
         object_list[m_object_index].position = object_list[m_object_index].initial_position;
         sn->setPosition(object_list[m_object_index].position);
@@ -167,6 +168,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
     if (m_object_index != -1 && App::GetCameraManager()->GetCurrentBehavior() != CameraManager::CAMERA_BEHAVIOR_FREE)
     {
         SceneNode* sn = object_list[m_object_index].node;
+        App::GetSimTerrain()->getObjectManager()->UnbatchObjectVisuals(sn); // The object is about to be edited
 
         Vector3 translation = Vector3::ZERO;
         float rotation = 0.0f;
@@ -152,24 +152,36 @@ TerrainGeometryManager::~TerrainGeometryManager()
     }
 }
 
+void TerrainGeometryManager::buildHeightCells()
+{
+    const int num_cells = mSize - 1;
+    m_height_cells.resize(num_cells * num_cells);
+    for (int y = 0; y < num_cells; y++)
+    {
+        for (int x = 0; x < num_cells; x++)
+        {
+            const float h0 = mHeightData[ y      * mSize + x    ];
+            const float h1 = mHeightData[ y      * mSize + x + 1];
+            const float h2 = mHeightData[(y + 1) * mSize + x + 1];
+            const float h3 = mHeightData[(y + 1) * mSize + x    ];
+
+            HeightCell& cell = m_height_cells[y * num_cells + x];
+            cell.h0   = h0;
+            cell.dx   = h1 - h0;
+            cell.dy   = h3 - h0;
+            cell.diag = h2 - h0;
+        }
+    }
+}
+
 /// @author Ported from OGRE engine, www.ogre3d.org, file OgreTerrain.cpp
-float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
+float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y, float& out_slope_x, float& out_slope_y)
 {
     // get left / bottom points (rounded down)
     Real factor = (Real)mSize - 1.0f;
-    Real invFactor = 1.0f / factor;
-
-    long startX = static_cast<long>(x * factor);
-    long startY = static_cast<long>(y * factor);
-    long endX = startX + 1;
-    long endY = startY + 1;
 
-    // now get points in terrain space (effectively rounding them to boundaries)
-    // note that we do not clamp! We need a valid plane
-    Real startXTS = startX * invFactor;
-    Real startYTS = startY * invFactor;
-    Real endXTS = endX * invFactor;
-    Real endYTS = endY * invFactor;
+    long startX = std::min(static_cast<long>(x * factor), static_cast<long>(mSize) - 2);
+    long startY = std::min(static_cast<long>(y * factor), static_cast<long>(mSize) - 2);
 
     // get parametric from start coord to next point
     Real xParam = (x * factor - startX);
@@ -182,28 +194,22 @@ float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
     0---1   0---1
     */
 
-    // Build all 4 positions in terrain space, using point-sampled height
-    Vector3 v0(startXTS, startYTS, mHeightData[startY * mSize + startX]);
-    Vector3 v1(endXTS  , startYTS, mHeightData[startY * mSize + endX]);
-    Vector3 v2(endXTS  , endYTS  , mHeightData[endY   * mSize + endX]);
-    Vector3 v3(startXTS, endYTS  , mHeightData[endY   * mSize + startX]);
-
-    // define this plane in terrain space
-    Vector3 normal;
-    Real d;
+    const HeightCell& cell = m_height_cells[startY * (mSize - 1) + startX];
+    Real base = cell.h0;
     if (startY % 2)
     {
         // odd row
         bool secondTri = ((1.0 - yParam) > xParam);
         if (secondTri)
         {
-            normal = (v1 - v0).crossProduct(v3 - v0);
-            d = -normal.dotProduct(v0);
+            out_slope_x = cell.dx;
+            out_slope_y = cell.dy;
         }
         else
         {
-            normal = (v2 - v1).crossProduct(v3 - v1);
-            d = -normal.dotProduct(v1);
+            out_slope_x = cell.diag - cell.dy;
+            out_slope_y = cell.diag - cell.dx;
+            base += cell.dx + cell.dy - cell.diag;
         }
     }
     else
@@ -212,18 +218,17 @@ float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
         bool secondTri = (yParam > xParam);
         if (secondTri)
         {
-            normal = (v2 - v0).crossProduct(v3 - v0);
-            d = -normal.dotProduct(v0);
+            out_slope_x = cell.diag - cell.dy;
+            out_slope_y = cell.dy;
         }
         else
         {
-            normal = (v1 - v0).crossProduct(v2 - v0);
-            d = -normal.dotProduct(v0);
+            out_slope_x = cell.dx;
+            out_slope_y = cell.diag - cell.dx;
         }
     }
 
-    // Solve plane equation for z
-    return (-normal.x * x - normal.y * y - d) / normal.z;
+    return base + out_slope_x * xParam + out_slope_y * yParam;
 }
 
 float TerrainGeometryManager::getHeightAt(float x, float z)
@@ -239,17 +244,41 @@ float TerrainGeometryManager::getHeightAt(float x, float z)
     else if (mIsFlat)
         return mMinHeight;
 
-    return getHeightAtTerrainPosition(tx, ty);
+    float slope_x, slope_y;
+    return getHeightAtTerrainPosition(tx, ty, slope_x, slope_y);
 }
 
 Ogre::Vector3 TerrainGeometryManager::getNormalAt(float x, float y, float z)
 {
-    const float precision = 0.1f;
-    Vector3 normal(getHeightAt(x - precision, z) - y, precision, y - getHeightAt(x, z + precision));
-    normal.normalise();
+    Vector3 normal;
+    this->getHeightAndNormalAt(x, z, normal);
     return normal;
 }
 
+float TerrainGeometryManager::getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    out_normal = Vector3::UNIT_Y;
+
+    if (m_spec->is_flat)
+        return 0.0f;
+
+    float tx = (x - mBase - mPos.x) / ((mSize - 1) *  mScale);
+    float ty = (z + mBase - mPos.z) / ((mSize - 1) * -mScale);
+
+    if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
+        return terrainManager->GetDef().water_bottom_height;
+    else if (mIsFlat)
+        return mMinHeight;
+
+    float slope_x, slope_y;
+    const float height = getHeightAtTerrainPosition(tx, ty, slope_x, slope_y);
+
+    // One cell spans 'mScale' world units; terrain Y runs along world -Z
+    out_normal = Vector3(-slope_x, mScale, slope_y);
+    out_normal.normalise();
+    return height;
+}
+
 bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
 {
     OTCParser otc_parser;
@@ -349,6 +378,10 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
         }
     }
     mIsFlat = std::abs(mMaxHeight - mMinHeight) < std::numeric_limits<float>::epsilon();
+    if (!mIsFlat)
+    {
+        this->buildHeightCells();
+    }
 
     if (m_was_new_geometry_generated)
     {
@@ -46,6 +46,9 @@ public:
 
     Ogre::Vector3 getNormalAt(float x, float y, float z);
 
+    /// Resolves the terrain triangle once and returns both height and (normalized) surface normal.
+    float getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal);
+
     Ogre::Vector3 getMaxTerrainSize();
 
     bool isFlat() { return mIsFlat; };
@@ -55,7 +58,19 @@ public:
 
 private:
 
-    float getHeightAtTerrainPosition(float x, float z);
+    /// Per-cell plane coefficients of the heightfield, in cell-parametric space.
+    /// Both tris of a cell are expressed using corner heights h0..h3: `h0`, `dx = h1 - h0`, `dy = h3 - h0`, `diag = h2 - h0`.
+    struct HeightCell
+    {
+        float h0;
+        float dx;
+        float dy;
+        float diag;
+    };
+
+    void  buildHeightCells();
+    /// Returns height; 'out_slope_x/y' receive the height gradient per cell (in cell-parametric units).
+    float getHeightAtTerrainPosition(float x, float z, float& out_slope_x, float& out_slope_y);
 
     bool getTerrainImage(int x, int y, Ogre::Image& img);
     bool loadTerrainConfig(Ogre::String filename);
@@ -77,6 +92,7 @@ private:
     Ogre::Real mScale;
     Ogre::uint16 mSize;
     float* mHeightData;
+    std::vector<HeightCell> m_height_cells; //!< (mSize - 1)^2 cells, row-major like `mHeightData`
 
     bool  mIsFlat;
     float mMinHeight;
@@ -182,6 +182,7 @@ TerrainManager* TerrainManager::LoadAndPrepareTerrain(CacheEntry& entry)
 
     loading_window->SetProgress(60, _L("Initializing Collision Subsystem"));
     terrn_mgr->m_collisions = new Collisions(terrn_mgr->getMaxTerrainSize());
+    terrn_mgr->m_collisions->setupCollisionCache(entry); // Precomputed collision geometry, verified while loading objects
 
     loading_window->SetProgress(75, _L("Initializing Script Subsystem"));
     App::SetSimTerrain(terrn_mgr.get()); // Hack for GameScript::spawnObject()
@@ -438,10 +439,7 @@ void TerrainManager::initShadows()
 
 void TerrainManager::loadTerrainObjects()
 {
-    for (std::string tobj_filename : m_def.tobj_files)
-    {
-        m_object_manager->LoadTObjFile(tobj_filename);
-    }
+    m_object_manager->LoadTObjFiles(m_def.tobj_files);
 
     m_object_manager->PostLoadTerrain(); // bakes the geometry and things
 }
@@ -507,6 +505,11 @@ Ogre::Vector3 TerrainManager::GetNormalAt(float x, float y, float z)
     return m_geometry_manager->getNormalAt(x, y, z);
 }
 
+float TerrainManager::GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    return m_geometry_manager->getHeightAndNormalAt(x, z, out_normal);
+}
+
 SkyManager* TerrainManager::getSkyManager()
 {
     return m_sky_manager;
@@ -68,6 +68,7 @@ public:
     void               HandleException(const char* summary);
     float              GetHeightAt(float x, float z);
     Ogre::Vector3      GetNormalAt(float x, float y, float z);
+    float              GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal);
 
     static const int UNLIMITED_SIGHTRANGE = 4999;
 
@@ -24,6 +24,7 @@
 #include "Application.h"
 #include "AutoPilot.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "Collisions.h"
 #include "Console.h"
 #include "ErrorUtils.h"
@@ -40,11 +41,13 @@
 #include "SoundScriptManager.h"
 #include "TerrainGeometryManager.h"
 #include "TerrainManager.h"
+#include "ThreadPool.h"
 #include "TObjFileFormat.h"
 #include "Utils.h"
 #include "WriteTextToTexture.h"
 
 #include <RTShaderSystem/OgreRTShaderSystem.h>
+#include <random>
 #include <Overlay/OgreFontManager.h>
 
 #ifdef USE_ANGELSCRIPT
@@ -61,6 +64,11 @@ inline float getTerrainHeight(Real x, Real z, void* unused = 0)
     return App::GetSimTerrain()->GetHeightAt(x, z);
 }
 
+// PagedGeometry pre-caches one page per interval ahead of the camera; pages which enter view uncached are
+// all built within a single `update()` - cache them sooner so that fewer pages arrive uncached.
+static const unsigned long PAGED_GEOMETRY_CACHE_INTERVAL_MS = 50;  // PagedGeometry default: 200
+static const unsigned long PAGED_GEOMETRY_PAGE_LIFE_MS      = 2000; // PagedGeometry default
+
 TerrainObjectManager::TerrainObjectManager(TerrainManager* terrainManager) :
     terrainManager(terrainManager)
 {
@@ -89,6 +97,10 @@ TerrainObjectManager::~TerrainObjectManager()
         App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry("bakeSG");
         m_staticgeometry = nullptr;
     }
+    for (ObjectBatch& batch : m_object_batches)
+    {
+        App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry(batch.geometry);
+    }
     if (m_procedural_mgr != nullptr)
     {
         delete m_procedural_mgr;
@@ -152,29 +164,169 @@ void GenerateGridAndPutToScene(Ogre::Vector3 position)
     n->setVisible(true);
 }
 
-void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
+void TerrainObjectManager::LoadTObjFiles(std::list<std::string> const& tobj_names)
 {
-    std::shared_ptr<TObjFile> tobj;
-    try
+    // Staged loading: read all sources on main thread (Ogre resource system isn't thread-safe),
+    // parse them on worker threads, then build the scene graph on main thread.
+
+    std::vector<SourceLoad> tobj_loads;
+    for (std::string const& tobj_name : tobj_names)
     {
-        DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
-            tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
-        TObjParser parser;
-        parser.Prepare();
-        parser.ProcessOgreStream(stream_ptr.get());
-        tobj = parser.Finalize();
+        SourceLoad load;
+        load.name = tobj_name;
+        try
+        {
+            DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            load.source = stream_ptr->getAsString();
+        }
+        catch (Ogre::Exception& e)
+        {
+            load.error = e.getFullDescription();
+        }
+        tobj_loads.push_back(load);
     }
-    catch (Ogre::Exception& e)
+
+    std::vector<std::shared_ptr<TObjFile>> tobjs(tobj_loads.size());
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < tobj_loads.size(); i++)
     {
-        LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.getFullDescription());
-        return;
+        if (tobj_loads[i].error.empty())
+        {
+            SourceLoad* load = &tobj_loads[i];
+            std::shared_ptr<TObjFile>* out_tobj = &tobjs[i];
+            tasks.push_back([load, out_tobj]()
+                {
+                    try
+                    {
+                        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(&load->source[0], load->source.size(), /*freeOnClose=*/false, /*readOnly=*/true));
+                        TObjParser parser;
+                        parser.Prepare();
+                        parser.ProcessOgreStream(stream.get());
+                        *out_tobj = parser.Finalize();
+                    }
+                    catch (std::exception& e)
+                    {
+                        load->error = e.what();
+                    }
+                });
+        }
     }
-    catch (std::exception& e)
+    App::GetThreadPool()->Parallelize(tasks);
+
+    // Each .odef is parsed once, however many objects use it
+    std::set<std::string> odef_names;
+    for (size_t i = 0; i < tobjs.size(); i++)
     {
-        LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.what());
-        return;
+        if (tobjs[i] == nullptr)
+        {
+            LOG("[RoR|Terrain] Error reading TObj file: " + tobj_loads[i].name + "\nMessage" + tobj_loads[i].error);
+            continue;
+        }
+        for (TObjEntry& entry : tobjs[i]->objects)
+        {
+            odef_names.insert(entry.odef_name);
+        }
+    }
+    this->PreloadODefs(odef_names);
+
+    // Triangulate all collision meshes up front
+    std::set<std::string> cmesh_names;
+    for (std::shared_ptr<TObjFile>& tobj : tobjs)
+    {
+        if (tobj == nullptr)
+            continue;
+        if (App::gfx_vegetation_mode->GetEnum<GfxVegetation>() != GfxVegetation::NONE)
+        {
+            for (TObjTree& tree : tobj->trees)
+            {
+                if (strlen(tree.collision_mesh))
+                    cmesh_names.insert(tree.collision_mesh);
+            }
+        }
+        for (TObjEntry& entry : tobj->objects)
+        {
+            auto search_res = m_odef_cache.find(entry.odef_name);
+            if (search_res != m_odef_cache.end())
+            {
+                for (ODefCollisionMesh& cmesh : search_res->second->collision_meshes)
+                    cmesh_names.insert(cmesh.mesh_name);
+            }
+        }
+    }
+    terrainManager->GetCollisions()->prepareCollisionMeshes(std::vector<Ogre::String>(cmesh_names.begin(), cmesh_names.end()));
+
+    for (std::shared_ptr<TObjFile>& tobj : tobjs)
+    {
+        if (tobj != nullptr)
+        {
+            this->ProcessTObjFile(*tobj);
+        }
+    }
+}
+
+void TerrainObjectManager::PreloadODefs(std::set<std::string> const& odef_names)
+{
+    std::vector<SourceLoad> odef_loads;
+    for (std::string const& odef_name : odef_names)
+    {
+        if (m_odef_cache.find(odef_name) != m_odef_cache.end())
+            continue;
+
+        SourceLoad load;
+        load.name = odef_name;
+        try
+        {
+            const std::string filename = odef_name + ".odef";
+            const std::string group_name = Ogre::ResourceGroupManager::getSingleton().findGroupContainingResource(filename);
+            load.source = Ogre::ResourceGroupManager::getSingleton().openResource(filename, group_name)->getAsString();
+        }
+        catch (...) // Not found - leave it to `FetchODef()` to report
+        {
+            continue;
+        }
+        odef_loads.push_back(load);
     }
 
+    std::vector<std::shared_ptr<ODefFile>> odefs(odef_loads.size());
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < odef_loads.size(); i++)
+    {
+        SourceLoad* load = &odef_loads[i];
+        std::shared_ptr<ODefFile>* out_odef = &odefs[i];
+        tasks.push_back([load, out_odef]()
+            {
+                try
+                {
+                    Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(&load->source[0], load->source.size(), /*freeOnClose=*/false, /*readOnly=*/true));
+                    ODefParser parser;
+                    parser.Prepare();
+                    parser.ProcessOgreStream(stream.get());
+                    *out_odef = parser.Finalize();
+                }
+                catch (std::exception& e)
+                {
+                    load->error = e.what();
+                }
+            });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    for (size_t i = 0; i < odefs.size(); i++)
+    {
+        if (odefs[i] != nullptr)
+        {
+            m_odef_cache.insert(std::make_pair(odef_loads[i].name, odefs[i]));
+        }
+        else
+        {
+            LOG("[RoR|Terrain] Error reading ODef file: " + odef_loads[i].name + ".odef\nMessage" + odef_loads[i].error);
+        }
+    }
+}
+
+void TerrainObjectManager::ProcessTObjFile(TObjFile& tobj)
+{
     if (m_procedural_mgr == nullptr)
     {
         m_procedural_mgr = new ProceduralManager();
@@ -184,15 +336,15 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     int mapsizez = terrainManager->getGeometryManager()->getMaxTerrainSize().z;
 
     // Section 'grid'
-    if (tobj->grid_enabled)
+    if (tobj.grid_enabled)
     {
-        GenerateGridAndPutToScene(tobj->grid_position);
+        GenerateGridAndPutToScene(tobj.grid_position);
     }
 
     // Section 'trees'
     if (App::gfx_vegetation_mode->GetEnum<GfxVegetation>() != GfxVegetation::NONE)
     {
-        for (TObjTree tree : tobj->trees)
+        for (TObjTree tree : tobj.trees)
         {
             this->ProcessTree(
                 tree.yaw_from, tree.yaw_to,
@@ -206,7 +358,7 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     // Section 'grass' / 'grass2'
     if (App::gfx_vegetation_mode->GetEnum<GfxVegetation>() != GfxVegetation::NONE)
     {
-        for (TObjGrass grass : tobj->grass)
+        for (TObjGrass grass : tobj.grass)
         {
             this->ProcessGrass(
                 grass.sway_speed, grass.sway_length, grass.sway_distrib, grass.density,
@@ -218,13 +370,10 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     }
 
     // Procedural roads
-    for (ProceduralObject po : tobj->proc_objects)
-    {
-        m_procedural_mgr->addObject(po);
-    }
+    m_procedural_mgr->addObjects(tobj.proc_objects);
 
     // Vehicles
-    for (TObjVehicle veh : tobj->vehicles)
+    for (TObjVehicle veh : tobj.vehicles)
     {
         if ((veh.type == TObj::SpecialObject::BOAT) && (terrainManager->getWater() == nullptr))
         {
@@ -251,10 +400,12 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     }
 
     // Entries
-    for (TObjEntry entry : tobj->objects)
+    m_collect_batch_candidates = true;
+    for (TObjEntry entry : tobj.objects)
     {
         this->LoadTerrainObject(entry.odef_name, entry.position, entry.rotation, m_staticgeometry_bake_node, entry.instance_name, entry.type);
     }
+    m_collect_batch_candidates = false;
 
     if (App::diag_terrn_log_roads->GetBool())
     {
@@ -301,11 +452,11 @@ void TerrainObjectManager::ProcessTree(
     float min = minDist * terrainManager->getPagedDetailFactor();
     if (min < 10)
         min = 10;
-    geom->addDetailLevel<BatchPage>(min, min / 2);
+    geom->addDetailLevel<BatchPage>(min, min / 2)->setCacheSpeed(PAGED_GEOMETRY_CACHE_INTERVAL_MS, PAGED_GEOMETRY_PAGE_LIFE_MS);
     float max = maxDist * terrainManager->getPagedDetailFactor();
     if (max < 10)
         max = 10;
-    geom->addDetailLevel<ImpostorPage>(max, max / 10);
+    geom->addDetailLevel<ImpostorPage>(max, max / 10)->setCacheSpeed(PAGED_GEOMETRY_CACHE_INTERVAL_MS, PAGED_GEOMETRY_PAGE_LIFE_MS);
     TreeLoader2D *treeLoader = new TreeLoader2D(geom, TBounds(0, 0, mapsizex, mapsizez));
     geom->setPageLoader(treeLoader);
     treeLoader->setHeightFunction(&getTerrainHeight);
@@ -315,62 +466,96 @@ void TerrainObjectManager::ProcessTree(
     }
 
     Entity* curTree = App::GetGfxScene()->GetSceneManager()->createEntity(String("paged_") + treemesh + TOSTRING(m_paged_geometry.size()), treemesh);
+    const uint32_t layer_seed = static_cast<uint32_t>(Math::RangeRandom(0.f, 16777216.f)); // Drawn on main thread; each layer differs
 
-    if (gridspacing > 0)
+    // Sample the density map and place trees on worker threads, a block of map columns per task;
+    // the loader and collisions aren't thread-safe, so trees are added on main thread afterwards.
+    struct TreePlacement
     {
-        // grid style
-        for (float x=0; x < mapsizex; x += gridspacing)
-        {
-            for (float z=0; z < mapsizez; z += gridspacing)
-            {
-                float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
-                if (density < 0.8f) continue;
-                float nx = x + gridspacing * 0.5f;
-                float nz = z + gridspacing * 0.5f;
-                float yaw = Math::RangeRandom(yawfrom, yawto);
-                float scale = Math::RangeRandom(scalefrom, scaleto);
-                Vector3 pos = Vector3(nx, 0, nz);
-                treeLoader->addTree(curTree, pos, Degree(yaw), (Ogre::Real)scale);
-                if (strlen(treeCollmesh))
-                {
-                    pos.y = terrainManager->GetHeightAt(pos.x, pos.z);
-                    scale *= 0.1f;
-                    terrainManager->GetCollisions()->addCollisionMesh(String(treeCollmesh), pos, Quaternion(Degree(yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
-                }
-            }
-        }
+        Vector3 pos;
+        float   yaw;
+        float   scale;
+    };
+    const bool grid_style = (gridspacing > 0);
+    float gridsize = 10;
+    if (grid_style)
+    {
+        gridsize = gridspacing;
     }
-    else
+    else if (gridspacing < 0 && gridspacing != 0)
     {
-        float gridsize = 10;
-        if (gridspacing < 0 && gridspacing != 0)
-        {
-            gridsize = -gridspacing;
-        }
-        float hd = highdens;
-        // normal style, random
-        for (float x=0; x < mapsizex; x += gridsize)
-        {
-            for (float z=0; z < mapsizez; z += gridsize)
+        gridsize = -gridspacing;
+    }
+    const bool has_collision = (strlen(treeCollmesh) > 0);
+    const float detail_factor = terrainManager->getPagedDetailFactor();
+    const int num_columns = static_cast<int>(std::ceil(mapsizex / gridsize));
+    const int COLUMNS_PER_TASK = 32;
+    std::vector<std::vector<TreePlacement>> placements((num_columns + COLUMNS_PER_TASK - 1) / COLUMNS_PER_TASK);
+    std::vector<std::function<void()>> tasks;
+    for (size_t block = 0; block < placements.size(); block++)
+    {
+        tasks.push_back([=, &placements]()
             {
-                if (highdens < 0) hd = Math::RangeRandom(0, -highdens);
-                float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
-                int numTreesToPlace = (int)((float)(hd) * density * terrainManager->getPagedDetailFactor());
-                float nx=0, nz=0;
-                while(numTreesToPlace-->0)
+                std::seed_seq seed{layer_seed, static_cast<uint32_t>(block)}; // Decorrelates the per-block streams
+                std::minstd_rand rng(seed);
+                auto range_random = [&rng](float low, float high)
+                    {
+                        return low + (high - low) * std::uniform_real_distribution<float>(0.f, 1.f)(rng);
+                    };
+
+                std::vector<TreePlacement>& out = placements[block];
+                const int end_column = std::min(static_cast<int>(block + 1) * COLUMNS_PER_TASK, num_columns);
+                for (int column = static_cast<int>(block) * COLUMNS_PER_TASK; column < end_column; column++)
+                {
+                    const float x = column * gridsize;
+                    for (float z=0; z < mapsizez; z += gridsize)
+                    {
+                        float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
+                        if (grid_style)
+                        {
+                            if (density < 0.8f) continue;
+                            TreePlacement tree;
+                            tree.pos = Vector3(x + gridsize * 0.5f, 0, z + gridsize * 0.5f);
+                            tree.yaw = range_random(yawfrom, yawto);
+                            tree.scale = range_random(scalefrom, scaleto);
+                            out.push_back(tree);
+                        }
+                        else
+                        {
+                            float hd = (highdens < 0) ? range_random(0, -highdens) : highdens;
+                            int numTreesToPlace = (int)((float)(hd) * density * detail_factor);
+                            while(numTreesToPlace-->0)
+                            {
+                                TreePlacement tree;
+                                tree.pos = Vector3(range_random(x, x + gridsize), 0, range_random(z, z + gridsize));
+                                tree.yaw = range_random(yawfrom, yawto);
+                                tree.scale = range_random(scalefrom, scaleto);
+                                out.push_back(tree);
+                            }
+                        }
+                    }
+                }
+
+                if (has_collision)
                 {
-                    nx = Math::RangeRandom(x, x + gridsize);
-                    nz = Math::RangeRandom(z, z + gridsize);
-                    float yaw = Math::RangeRandom(yawfrom, yawto);
-                    float scale = Math::RangeRandom(scalefrom, scaleto);
-                    Vector3 pos = Vector3(nx, 0, nz);
-                    treeLoader->addTree(curTree, pos, Degree(yaw), (Ogre::Real)scale);
-                    if (strlen(treeCollmesh))
+                    for (TreePlacement& tree : out)
                     {
-                        pos.y = terrainManager->GetHeightAt(pos.x, pos.z);
-                        terrainManager->GetCollisions()->addCollisionMesh(String(treeCollmesh),pos, Quaternion(Degree(yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
+                        tree.pos.y = terrainManager->GetHeightAt(tree.pos.x, tree.pos.z);
                     }
                 }
+            });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    for (std::vector<TreePlacement>& block : placements)
+    {
+        for (TreePlacement& tree : block)
+        {
+            treeLoader->addTree(curTree, Vector3(tree.pos.x, 0, tree.pos.z), Degree(tree.yaw), (Ogre::Real)tree.scale);
+            if (has_collision)
+            {
+                float scale = (grid_style) ? (tree.scale * 0.1f) : tree.scale;
+                terrainManager->GetCollisions()->addCollisionMesh(String(treeCollmesh), tree.pos, Quaternion(Degree(tree.yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
             }
         }
     }
@@ -390,7 +575,8 @@ void TerrainObjectManager::ProcessGrass(
         PagedGeometry *grass = new PagedGeometry(App::GetCameraManager()->GetCamera(), 30);
         //Set up LODs
 
-        grass->addDetailLevel<GrassPage>(range * terrainManager->getPagedDetailFactor()); // original value: 80
+        grass->addDetailLevel<GrassPage>(range * terrainManager->getPagedDetailFactor()) // original value: 80
+            ->setCacheSpeed(PAGED_GEOMETRY_CACHE_INTERVAL_MS, PAGED_GEOMETRY_PAGE_LIFE_MS);
 
         //Set up a GrassLoader for easy use
         GrassLoader *grassLoader = new GrassLoader(grass);
@@ -467,6 +653,131 @@ void TerrainObjectManager::PostLoadTerrain()
     {
         LOG("error while baking roads. ignoring.");
     }
+
+    this->BuildObjectBatches();
+}
+
+void TerrainObjectManager::BuildObjectBatches()
+{
+    // Region size as with the baked geometry above; Ogre culls static geometry per region.
+    const float region_size = terrainManager->getFarClip() / 2.0f;
+    std::map<std::pair<int, int>, int> region_batches;
+    for (auto& candidate : m_batch_candidates)
+    {
+        const Vector3 pos = candidate.first->getPosition();
+        const std::pair<int, int> region(static_cast<int>(std::floor(pos.x / region_size)), static_cast<int>(std::floor(pos.z / region_size)));
+        auto found = region_batches.find(region);
+        if (found == region_batches.end())
+        {
+            ObjectBatch batch;
+            batch.geometry = App::GetGfxScene()->GetSceneManager()->createStaticGeometry(
+                "ObjectBatch-" + TOSTRING(region.first) + "-" + TOSTRING(region.second));
+            batch.geometry->setCastShadows(true);
+            batch.geometry->setRegionDimensions(Vector3(region_size, 10000.0, region_size));
+            batch.geometry->setRenderingDistance(terrainManager->getFarClip());
+            batch.region_min = Vector2(region.first * region_size, region.second * region_size);
+            batch.region_max = batch.region_min + Vector2(region_size, region_size);
+            m_object_batches.push_back(batch);
+            found = region_batches.insert(std::make_pair(region, static_cast<int>(m_object_batches.size()) - 1)).first;
+        }
+        m_object_batches[found->second].members.push_back(candidate);
+        m_batched_nodes[candidate.first] = found->second;
+    }
+    m_batch_candidates.clear();
+
+    for (ObjectBatch& batch : m_object_batches)
+    {
+        this->BuildObjectBatch(batch); // Entities stay attached until their batch is built
+    }
+
+    LOG("[RoR|Terrain] Batched " + TOSTRING(m_batched_nodes.size()) + " static objects in " + TOSTRING(m_object_batches.size()) + " regions");
+}
+
+bool TerrainObjectManager::BuildObjectBatch(ObjectBatch& batch)
+{
+    try
+    {
+        batch.geometry->reset();
+        for (auto& member : batch.members)
+        {
+            SceneNode* node = member.first;
+            batch.geometry->addEntity(member.second, node->getPosition(), node->getOrientation(), node->getScale());
+        }
+        batch.geometry->build();
+    }
+    catch (Ogre::Exception& e)
+    {
+        // Drop the batch - its objects are rendered as plain entities again.
+        LOG("[RoR|Terrain] Error building static object batch: " + e.getFullDescription());
+        batch.geometry->reset();
+        for (auto& member : batch.members)
+        {
+            if (!member.second->isAttached())
+                member.first->attachObject(member.second);
+            m_batched_nodes.erase(member.first);
+        }
+        batch.members.clear();
+        batch.dirty = false;
+        return false;
+    }
+
+    for (auto& member : batch.members)
+    {
+        if (member.second->isAttached())
+            member.first->detachObject(member.second);
+    }
+    batch.geometry->setVisible(true);
+    batch.dirty = false;
+    return true;
+}
+
+void TerrainObjectManager::UpdateObjectBatches()
+{
+    // Rebuilding takes a while, so it's only done where it can't be seen, and at most once per frame.
+    const Vector3 camera_pos = App::GetCameraManager()->GetCamera()->getDerivedPosition();
+    const float rendering_distance = terrainManager->getFarClip();
+    for (ObjectBatch& batch : m_object_batches)
+    {
+        if (!batch.dirty)
+            continue;
+
+        const float dx = std::max(std::max(batch.region_min.x - camera_pos.x, camera_pos.x - batch.region_max.x), 0.f);
+        const float dz = std::max(std::max(batch.region_min.y - camera_pos.z, camera_pos.z - batch.region_max.y), 0.f);
+        if (dx * dx + dz * dz > rendering_distance * rendering_distance)
+        {
+            this->BuildObjectBatch(batch);
+            return;
+        }
+    }
+}
+
+void TerrainObjectManager::UnbatchObjectVisuals(Ogre::SceneNode* node)
+{
+    auto found = m_batched_nodes.find(node);
+    if (found == m_batched_nodes.end())
+        return;
+
+    ObjectBatch& batch = m_object_batches[found->second];
+    if (!batch.dirty)
+    {
+        // Hide the batch rather than rebuilding it right away; the members are drawn as plain entities meanwhile.
+        batch.geometry->setVisible(false);
+        for (auto& member : batch.members)
+        {
+            if (!member.second->isAttached())
+                member.first->attachObject(member.second);
+        }
+        batch.dirty = true;
+    }
+    for (auto itor = batch.members.begin(); itor != batch.members.end(); ++itor)
+    {
+        if (itor->first == node)
+        {
+            batch.members.erase(itor);
+            break;
+        }
+    }
+    m_batched_nodes.erase(found);
 }
 
 void TerrainObjectManager::MoveObjectVisuals(const String& instancename, const Ogre::Vector3& pos)
@@ -482,6 +793,7 @@ void TerrainObjectManager::MoveObjectVisuals(const String& instancename, const O
     if (!obj.enabled)
         return;
 
+    this->UnbatchObjectVisuals(obj.sceneNode);
     obj.sceneNode->setPosition(pos);
 }
 
@@ -502,11 +814,16 @@ void TerrainObjectManager::unloadObject(const String& instancename)
     {
         terrainManager->GetCollisions()->removeCollisionTri(tri);
     }
+    for (auto inst : obj.collMeshInstances)
+    {
+        terrainManager->GetCollisions()->removeCollisionMeshInstance(inst);
+    }
     for (auto box : obj.collBoxes)
     {
         terrainManager->GetCollisions()->removeCollisionBox(box);
     }
 
+    this->UnbatchObjectVisuals(obj.sceneNode);
     obj.sceneNode->detachAllObjects();
     obj.sceneNode->setVisible(false);
     obj.enabled = false;
@@ -595,6 +912,7 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
     obj->enabled = true;
     obj->sceneNode = tenode;
     obj->collTris.clear();
+    obj->collMeshInstances.clear();
 
     EditorObject object;
     object.name = name;
@@ -659,7 +977,7 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         auto gm = terrainManager->GetCollisions()->getGroundModelByString(cmesh.groundmodel_name);
         terrainManager->GetCollisions()->addCollisionMesh(
             cmesh.mesh_name, pos, tenode->getOrientation(),
-            cmesh.scale, gm, &(obj->collTris));
+            cmesh.scale, gm, &(obj->collTris), &(obj->collMeshInstances));
     }
 
     for (ODefParticleSys& psys : odef->particle_systems)
@@ -866,6 +1184,13 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         sn->attachObject(pointlight);
         sn->attachObject(lflare);
     }
+
+    // Batch plain static meshes, see `BuildObjectBatches()`
+    if (m_collect_batch_candidates && mo && mo->getEntity() && !mo->getEntity()->hasSkeleton() &&
+        odef->animations.empty() && !uniquifyMaterial)
+    {
+        m_batch_candidates.push_back(std::make_pair(tenode, mo->getEntity()));
+    }
 }
 
 bool TerrainObjectManager::UpdateAnimatedObjects(float dt)
@@ -923,6 +1248,7 @@ bool TerrainObjectManager::UpdateTerrainObjects(float dt)
     }
 
     this->UpdateAnimatedObjects(dt);
+    this->UpdateObjectBatches();
 
     return true;
 }
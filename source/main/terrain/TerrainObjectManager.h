@@ -24,6 +24,7 @@
 #include "Application.h"
 
 #include "ODefFileFormat.h"
+#include "TObjFileFormat.h"
 
 #include "BatchPage.h"
 #include "GrassLoader.h"
@@ -34,7 +35,9 @@
 #include "TreeLoader2D.h"
 #include "TreeLoader3D.h"
 
+#include <list>
 #include <map>
+#include <set>
 #include <unordered_map>
 
 namespace RoR {
@@ -71,10 +74,11 @@ public:
 
     std::vector<EditorObject>& GetEditorObjects() { return m_editor_objects; }
     std::vector<MapEntity>& GetMapEntities() { return m_map_entities; }
-    void           LoadTObjFile(Ogre::String filename);
+    void           LoadTObjFiles(std::list<std::string> const& filenames); //!< Parses all files up front, using the thread pool.
     void           LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, Ogre::SceneNode* m_staticgeometry_bake_node, const Ogre::String& instancename, const Ogre::String& type, bool enable_collisions = true, int scripthandler = -1, bool uniquifyMaterial = false);
     void           MoveObjectVisuals(const Ogre::String& instancename, const Ogre::Vector3& pos);
     void           unloadObject(const Ogre::String& instancename);
+    void           UnbatchObjectVisuals(Ogre::SceneNode* node); //!< Takes the object out of its static batch (without rebuilding it); call before modifying the node.
     void           LoadTelepoints();
     void           LoadPredefinedActors();
     bool           HasPredefinedActors() { return !m_predefined_actors.empty(); };
@@ -141,13 +145,45 @@ protected:
         bool enabled;
         std::vector<int> collBoxes;
         std::vector<int> collTris;
+        std::vector<int> collMeshInstances;
     };
 
+    /// Source file read on main thread, to be parsed on a worker thread.
+    struct SourceLoad
+    {
+        std::string name;
+        std::string source;
+        std::string error;
+    };
+
+    // TObj processing functions
+
+    void           ProcessTObjFile(TObjFile& tobj);
+
     // ODef processing functions
 
+    void           PreloadODefs(std::set<std::string> const& odef_names); //!< Parses uncached files in parallel.
     RoR::ODefFile* FetchODef(std::string const & odef_name);
     void           ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params);
 
+    /// Static (non-animated) entities placed by .tobj files are merged into region-based static geometry,
+    /// one `Ogre::StaticGeometry` per region, so each region draws one batch per material.
+    /// Scene nodes remain in place (with lights, particles etc.) and serve as per-instance handles.
+    struct ObjectBatch
+    {
+        Ogre::StaticGeometry*  geometry = nullptr;
+        std::vector<std::pair<Ogre::SceneNode*, Ogre::Entity*>> members;
+        Ogre::Vector2          region_min;    //!< Horizontal extent (X,Z) of the region
+        Ogre::Vector2          region_max;
+        bool                   dirty = false; //!< Member removed; the geometry is hidden and members are drawn as plain entities until rebuilt
+    };
+
+    // Object batching functions
+
+    void           BuildObjectBatches();
+    bool           BuildObjectBatch(ObjectBatch& batch); //!< Returns false if the batch was dropped
+    void           UpdateObjectBatches(); //!< Rebuilds a dirty batch once the camera is out of its rendering distance
+
     // Misc functions
 
     bool           UpdateAnimatedObjects(float dt);
@@ -170,6 +206,11 @@ protected:
     std::string               m_resource_group;
 
     std::vector<Forests::PagedGeometry*> m_paged_geometry;
+
+    std::vector<std::pair<Ogre::SceneNode*, Ogre::Entity*>> m_batch_candidates; //!< Collected while loading .tobj files
+    std::vector<ObjectBatch>                  m_object_batches;
+    std::unordered_map<Ogre::SceneNode*, int> m_batched_nodes; //!< Node -> index to `m_object_batches`
+    bool                                      m_collect_batch_candidates = false;
 };
 
 } // namespace RoR
@@ -34,6 +34,8 @@
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <unistd.h> // readlink()
+    #include <fcntl.h> // open()
+    #include <sys/mman.h> // mmap()
 #endif
 
 #include <OgrePlatform.h>
@@ -148,6 +150,76 @@ std::string GetExecutablePath()
     return MSW_WcharToUtf8(out_wstr.c_str());
 }
 
+bool GetFileSizeAndTime(std::string const & path, uint64_t& out_size, std::time_t& out_mtime)
+{
+    std::wstring wpath = MSW_Utf8ToWchar(path.c_str());
+    WIN32_FILE_ATTRIBUTE_DATA attrs;
+    if (!GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, &attrs))
+    {
+        return false;
+    }
+
+    out_size = (uint64_t(attrs.nFileSizeHigh) << 32) | attrs.nFileSizeLow;
+    // FILETIME counts 100ns intervals since 1601-01-01, time_t counts seconds since 1970-01-01
+    const uint64_t ticks = (uint64_t(attrs.ftLastWriteTime.dwHighDateTime) << 32) | attrs.ftLastWriteTime.dwLowDateTime;
+    out_mtime = static_cast<std::time_t>((ticks - 116444736000000000ULL) / 10000000ULL);
+    return true;
+}
+
+bool MappedFile::Open(std::string const& path)
+{
+    this->Close();
+
+    std::wstring wpath = MSW_Utf8ToWchar(path.c_str());
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file_handle = file;
+    m_mapping_handle = mapping;
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+}
+
 #else
 
 // -------------------------- File/path utils for Linux/*nix --------------------------
@@ -190,6 +262,58 @@ std::string GetExecutablePath()
     return std::move(buf_str);
 }
 
+bool GetFileSizeAndTime(std::string const & path, uint64_t& out_size, std::time_t& out_mtime)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+    {
+        return false;
+    }
+
+    out_size = static_cast<uint64_t>(st.st_size);
+    out_mtime = st.st_mtime;
+    return true;
+}
+
+bool MappedFile::Open(std::string const& path)
+{
+    this->Close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
 #endif // _MSC_VER
 
 // -------------------------- File/path common utils --------------------------
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <ctime>
 
@@ -52,5 +54,32 @@ std::string GetExecutablePath(); //!< Returns UTF-8 path or empty string on erro
 std::string GetParentDirectory(const char* path); //!< Returns UTF-8 path without trailing slash.
 
 std::time_t GetFileLastModifiedTime(std::string const & path);
+bool GetFileSizeAndTime(std::string const & path, uint64_t& out_size, std::time_t& out_mtime); //!< Single filesystem query; returns false if the file doesn't exist.
+
+/// Read-only view of a whole file, backed by the OS page cache.
+/// Multiple readers (even across processes) share the same physical pages.
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile() { this->Close(); }
+
+    bool        Open(std::string const& path); //!< Path must be UTF-8 encoded. Returns false if the file is missing, empty or cannot be mapped.
+    void        Close();
+    bool        IsOpen() const  { return m_data != nullptr; }
+    const char* GetData() const { return m_data; }
+    size_t      GetSize() const { return m_size; }
+
+private:
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+#ifdef _MSC_VER
+    void*       m_file_handle = nullptr;
+    void*       m_mapping_handle = nullptr;
+#endif
+};
 
 } // namespace RoR
@@ -0,0 +1,185 @@
+
+// Flexbody deformation: old per-vertex kernel (basis recomputed for every
+// vertex from its node triplet) versus the current one (basis computed once
+// per unique triplet, vertices processed in fixed-size SoA batches).
+
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Vec3
+{
+    Vec3(): x(0.f), y(0.f), z(0.f) {}
+    Vec3(float _x, float _y, float _z): x(_x), y(_y), z(_z) {}
+    Vec3 operator+(Vec3 const& v) const { return Vec3(x + v.x, y + v.y, z + v.z); }
+    Vec3 operator-(Vec3 const& v) const { return Vec3(x - v.x, y - v.y, z - v.z); }
+    Vec3 operator*(float f) const { return Vec3(x * f, y * f, z * f); }
+    float operator[](int i) const { return (&x)[i]; }
+    Vec3 cross(Vec3 const& v) const { return Vec3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x); }
+    float x, y, z;
+};
+
+struct Locator
+{
+    int ref, nx, ny, nz;
+    Vec3 coords;
+};
+
+struct Frame
+{
+    int ref, nx, ny;
+    Vec3 axis_x, axis_y, axis_n, origin;
+};
+
+inline Vec3 Normalise(Vec3 v)
+{
+    return v * (1.f / std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z));
+}
+
+static const int NUM_NODES = 500;
+static const int NUM_VERTICES = 50000;
+static const int VERTICES_PER_FRAME = 12; // Typical for detailed meshes
+
+static std::vector<Vec3> g_nodes;
+static std::vector<Locator> g_locators;
+static std::vector<Vec3> g_src_normals;
+static std::vector<Frame> g_frames;
+static std::vector<int> g_vertex_frames;
+static std::vector<Vec3> g_dst_pos;
+static std::vector<Vec3> g_dst_normals;
+
+static void PrepareFlexbody()
+{
+    srand(0);
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        g_nodes.push_back(Vec3(rand() % 100 * 0.1f, rand() % 100 * 0.1f, rand() % 100 * 0.1f));
+    }
+    for (int i = 0; i < NUM_VERTICES; ++i)
+    {
+        const int t = i / VERTICES_PER_FRAME;
+        Locator loc;
+        loc.ref = t % NUM_NODES;
+        loc.nx = (t * 7 + 1) % NUM_NODES;
+        loc.ny = (t * 13 + 2) % NUM_NODES;
+        loc.nz = 0;
+        loc.coords = Vec3(rand() % 100 * 0.01f, rand() % 100 * 0.01f, rand() % 100 * 0.01f);
+        g_locators.push_back(loc);
+        g_src_normals.push_back(Normalise(Vec3(0.3f, 0.5f, rand() % 100 * 0.01f + 0.1f)));
+
+        if (i % VERTICES_PER_FRAME == 0)
+        {
+            Frame frame;
+            frame.ref = loc.ref;
+            frame.nx = loc.nx;
+            frame.ny = loc.ny;
+            g_frames.push_back(frame);
+        }
+        g_vertex_frames.push_back(static_cast<int>(g_frames.size()) - 1);
+    }
+    g_dst_pos.resize(NUM_VERTICES);
+    g_dst_normals.resize(NUM_VERTICES);
+}
+
+static void Bench_PerVertex(benchmark::State& state)
+{
+    const Vec3 center = g_nodes[0];
+    while (state.KeepRunning())
+    {
+        for (int i = 0; i < NUM_VERTICES; i++)
+        {
+            Locator const& loc = g_locators[i];
+            Vec3 diffX = g_nodes[loc.nx] - g_nodes[loc.ref];
+            Vec3 diffY = g_nodes[loc.ny] - g_nodes[loc.ref];
+            Vec3 nCross = Normalise(diffX.cross(diffY));
+
+            g_dst_pos[i] = diffX * loc.coords.x + diffY * loc.coords.y + nCross * loc.coords.z;
+            g_dst_pos[i] = g_dst_pos[i] + (g_nodes[loc.ref] - center);
+            g_dst_normals[i] = Normalise(diffX * g_src_normals[i].x + diffY * g_src_normals[i].y + nCross * g_src_normals[i].z);
+        }
+        benchmark::DoNotOptimize(g_dst_pos.data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK(Bench_PerVertex);
+
+static void Bench_FramesSoA(benchmark::State& state)
+{
+    const Vec3 center = g_nodes[0];
+    const int BATCH = 8;
+    float ax[3][BATCH], ay[3][BATCH], an[3][BATCH], org[3][BATCH];
+    float coords[3][BATCH], src_norm[3][BATCH];
+    float pos[3][BATCH], norm[3][BATCH];
+    while (state.KeepRunning())
+    {
+        for (Frame& frame : g_frames)
+        {
+            frame.axis_x = g_nodes[frame.nx] - g_nodes[frame.ref];
+            frame.axis_y = g_nodes[frame.ny] - g_nodes[frame.ref];
+            frame.axis_n = Normalise(frame.axis_x.cross(frame.axis_y));
+            frame.origin = g_nodes[frame.ref] - center;
+        }
+
+        for (int start = 0; start < NUM_VERTICES; start += BATCH)
+        {
+            const int count = std::min(BATCH, NUM_VERTICES - start);
+            for (int k = 0; k < BATCH; k++)
+            {
+                const int i = start + std::min(k, count - 1);
+                Frame const& frame = g_frames[g_vertex_frames[i]];
+                for (int c = 0; c < 3; c++)
+                {
+                    ax[c][k]       = frame.axis_x[c];
+                    ay[c][k]       = frame.axis_y[c];
+                    an[c][k]       = frame.axis_n[c];
+                    org[c][k]      = frame.origin[c];
+                    coords[c][k]   = g_locators[i].coords[c];
+                    src_norm[c][k] = g_src_normals[i][c];
+                }
+            }
+            for (int c = 0; c < 3; c++)
+            {
+                for (int k = 0; k < BATCH; k++)
+                {
+                    pos[c][k]  = (ax[c][k] * coords[0][k] + ay[c][k] * coords[1][k] + an[c][k] * coords[2][k]) + org[c][k];
+                    norm[c][k] = ax[c][k] * src_norm[0][k] + ay[c][k] * src_norm[1][k] + an[c][k] * src_norm[2][k];
+                }
+            }
+            for (int k = 0; k < BATCH; k++)
+            {
+                const float inv_len = 1.f / std::sqrt(norm[0][k] * norm[0][k] + norm[1][k] * norm[1][k] + norm[2][k] * norm[2][k]);
+                norm[0][k] *= inv_len;
+                norm[1][k] *= inv_len;
+                norm[2][k] *= inv_len;
+            }
+            for (int k = 0; k < count; k++)
+            {
+                g_dst_pos[start + k]     = Vec3(pos[0][k], pos[1][k], pos[2][k]);
+                g_dst_normals[start + k] = Vec3(norm[0][k], norm[1][k], norm[2][k]);
+            }
+        }
+        benchmark::DoNotOptimize(g_dst_pos.data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK(Bench_FramesSoA);
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareFlexbody();
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return 0;
+}
@@ -0,0 +1,281 @@
+
+// Whole-file truck parsing throughput: old line-by-line reading (copy into
+// zeroed buffer, per-line UTF-8 sanitize, strtod) versus the current approach
+// (bulk read, one UTF-8 check, lines terminated in place, fast decimal parse).
+
+#include "benchmark/benchmark.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static const int LINE_BUFFER_LENGTH = 2000;
+static const int LINE_MAX_ARGS = 100;
+
+struct Token
+{
+    const char* start;
+    int length;
+};
+
+static std::string g_truckfile;
+static double g_sum = 0.0; // Keeps the optimizer from removing the work
+
+// ---------------------------------------------------------------------------
+// Test data: a synthetic but representative truck (mostly nodes and beams)
+
+static void PrepareTruckfile()
+{
+    std::stringstream s;
+    s << "Benchmark truck\n\n"
+      << "globals\n9000, 300, tracks/semi\n\n"
+      << "nodes\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+        s << i << ", " << (i % 17) * 0.25 << ", " << (i % 5) * 1.125 << ", " << -(i % 11) * 0.5 << ", l\n";
+    }
+    s << "\n;beams\nbeams\n";
+    for (int i = 0; i < 3000; ++i)
+    {
+        s << (i % 1000) << ", " << ((i * 7 + 1) % 1000) << ", i\n";
+        if (i % 100 == 0)
+        {
+            s << "set_beam_defaults -1, -1, -1, -1, 0.05, tracks/beam\n";
+        }
+    }
+    s << "\nend\n";
+    g_truckfile = s.str();
+}
+
+// ---------------------------------------------------------------------------
+// Helpers (simplified copies of RigDef::Parser logic)
+
+inline bool IsWhitespace(char c)
+{
+    return (c == ' ') || (c == '\t');
+}
+
+inline bool IsSeparator(char c)
+{
+    return IsWhitespace(c) || (c == ':') || (c == '|') || (c == ',');
+}
+
+static int Tokenize(const char* line, Token* args)
+{
+    int num_args = 0;
+    const char* cur_char = line;
+    Token token = { cur_char, 0 };
+    while ((*cur_char != '\0') && (num_args < LINE_MAX_ARGS))
+    {
+        if (IsSeparator(*cur_char))
+        {
+            if (token.length != 0)
+            {
+                args[num_args++] = token;
+            }
+            token.start = cur_char + 1;
+            token.length = 0;
+        }
+        else
+        {
+            ++token.length;
+        }
+        ++cur_char;
+    }
+    if ((token.length != 0) && (num_args < LINE_MAX_ARGS))
+    {
+        args[num_args++] = token;
+    }
+    return num_args;
+}
+
+inline bool TryParseDecimal(const char* start, const char* end, double& out_value)
+{
+    static const double POW10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    const char* pos = start;
+    const bool negative = (pos != end && *pos == '-');
+    if (pos != end && (*pos == '-' || *pos == '+'))
+    {
+        ++pos;
+    }
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int num_decimals = 0;
+    bool in_decimals = false;
+    for (; pos != end; ++pos)
+    {
+        if (*pos >= '0' && *pos <= '9')
+        {
+            if (++num_digits > 15)
+            {
+                return false;
+            }
+            mantissa = (mantissa * 10) + (*pos - '0');
+            if (in_decimals)
+            {
+                ++num_decimals;
+            }
+        }
+        else if (*pos == '.' && !in_decimals)
+        {
+            in_decimals = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (num_digits == 0 || num_decimals > 22)
+    {
+        return false;
+    }
+
+    const double value = static_cast<double>(mantissa) / POW10[num_decimals];
+    out_value = (negative) ? -value : value;
+    return true;
+}
+
+// Stands in for `utf8::replace_invalid()` - the real one decodes every sequence.
+static char* SanitizeAscii(const char* start, const char* end, char* out)
+{
+    for (; start != end; ++start)
+    {
+        *out++ = (static_cast<unsigned char>(*start) < 0x80) ? *start : '?';
+    }
+    return out;
+}
+
+static bool IsAscii(const char* start, const char* end)
+{
+    for (; start != end; ++start)
+    {
+        if (static_cast<unsigned char>(*start) >= 0x80)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ProcessLineArgs(const char* line, bool fast_numbers)
+{
+    Token args[LINE_MAX_ARGS];
+    int num_args = Tokenize(line, args);
+    for (int i = 0; i < num_args; ++i)
+    {
+        double value = 0.0;
+        if (fast_numbers && TryParseDecimal(args[i].start, args[i].start + args[i].length, value))
+        {
+            g_sum += value;
+            continue;
+        }
+
+        // Like `Parser::GetArgFloat()`: strtod() straight on the line, it stops at the separator
+        char* out_end = nullptr;
+        errno = 0;
+        g_sum += strtod(args[i].start, &out_end);
+        if (errno != 0 || out_end != args[i].start + args[i].length)
+        {
+            g_sum += 1.0; // Diagnostics path, not taken with the test data
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+
+static void Bench_LineByLine_Copy(benchmark::State& state)
+{
+    char raw_line_buf[LINE_BUFFER_LENGTH];
+    char current_line[LINE_BUFFER_LENGTH];
+    while (state.KeepRunning())
+    {
+        std::stringstream stream(g_truckfile); // Mimics `Ogre::DataStream::readLine()`
+        while (stream.getline(raw_line_buf, LINE_BUFFER_LENGTH))
+        {
+            const char* raw_start = raw_line_buf;
+            const char* raw_end = raw_line_buf + strnlen(raw_line_buf, LINE_BUFFER_LENGTH);
+            while (IsWhitespace(*raw_start) && (raw_start != raw_end))
+            {
+                ++raw_start;
+            }
+            if ((raw_start == raw_end) || (*raw_start == ';') || (*raw_start == '/'))
+            {
+                continue;
+            }
+
+            memset(current_line, 0, LINE_BUFFER_LENGTH);
+            SanitizeAscii(raw_start, raw_end, current_line);
+            ProcessLineArgs(current_line, false);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * g_truckfile.size());
+}
+BENCHMARK(Bench_LineByLine_Copy);
+
+static void Bench_WholeFile_InPlace(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        std::string contents = g_truckfile; // Mimics `Ogre::DataStream::getAsString()`
+        if (!IsAscii(contents.data(), contents.data() + contents.size()))
+        {
+            SanitizeAscii(contents.data(), contents.data() + contents.size(), &contents[0]);
+        }
+
+        char* buf_end = &contents[0] + contents.size();
+        char* line_start = &contents[0];
+        while (line_start < buf_end)
+        {
+            char* line_end = static_cast<char*>(memchr(line_start, '\n', buf_end - line_start));
+            if (line_end == nullptr)
+            {
+                line_end = buf_end;
+            }
+            char* next_line = (line_end == buf_end) ? buf_end : (line_end + 1);
+            if ((line_end != line_start) && (*(line_end - 1) == '\r'))
+            {
+                --line_end;
+            }
+            *line_end = '\0';
+
+            const char* line = line_start;
+            line_start = next_line;
+            while (IsWhitespace(*line))
+            {
+                ++line;
+            }
+            if ((*line == '\0') || (*line == ';') || (*line == '/'))
+            {
+                continue;
+            }
+
+            ProcessLineArgs(line, true);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * g_truckfile.size());
+}
+BENCHMARK(Bench_WholeFile_InPlace);
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareTruckfile();
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return (g_sum != 0.0) ? 0 : 1;
+}